@@ -0,0 +1,82 @@
+#ifndef VIPER_BENCH_BENCH_HH
+#define VIPER_BENCH_BENCH_HH
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Each benchmark is a single file that includes this header, so the global
+// allocation functions below replace the standard ones in its binary and
+// count every heap allocation made by the compiler
+namespace Bench
+{
+    inline std::atomic<std::size_t> allocations = 0;
+    inline std::atomic<std::size_t> allocatedBytes = 0;
+
+    struct Allocations
+    {
+        std::size_t count;
+        std::size_t bytes;
+    };
+
+    inline Allocations CountAllocations()
+    {
+        return { allocations.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed) };
+    }
+
+    inline Allocations operator-(Allocations lhs, Allocations rhs)
+    {
+        return { lhs.count - rhs.count, lhs.bytes - rhs.bytes };
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    inline double Milliseconds(Clock::time_point begin, Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    // Returns the fastest of the given number of runs, in milliseconds
+    template<typename F>
+    double Fastest(int runs, F function)
+    {
+        double fastest = 0;
+        for(int i = 0; i < runs; ++i)
+        {
+            Clock::time_point begin = Clock::now();
+            function();
+            double time = Milliseconds(begin, Clock::now());
+            if(i == 0 || time < fastest)
+                fastest = time;
+        }
+        return fastest;
+    }
+}
+
+// GCC takes the free() calls below for a mismatch with the builtin new
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(std::size_t size)
+{
+    Bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    Bench::allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if(void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#pragma GCC diagnostic pop
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <lexing/tokenStream.hh>
+#include <parsing/parser.hh>
+#include <source/sourceManager.hh>
+#include <ssa/builder.hh>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// How call sites were resolved before the module kept a name index: a walk
+// over every global, checking each one's kind and name
+static SSA::Function* FindByScan(SSA::Module& module, std::string_view name)
+{
+    for(SSA::Value* global : module.GetGlobals())
+    {
+        if(SSA::Function* function = dynamic_cast<SSA::Function*>(global))
+        {
+            if(function->GetName() == name)
+                return function;
+        }
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s <file> <functions> [runs]\n", argv[0]);
+        return 1;
+    }
+    std::size_t functions = std::stoul(argv[2]);
+    int runs = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    Lexing::TokenStream stream(tokens);
+    Parsing::Parser parser(stream, *file);
+    Parsing::AST ast = parser.Parse(1);
+
+    // Calls in the order their sites appear, which is the order the builder
+    // resolves them in
+    std::vector<Atom> callees;
+    for(std::size_t i = 0; i + 1 < tokens.Size(); ++i)
+    {
+        if(tokens.GetType(i) == Lexing::TokenType::Identifier && tokens.GetType(i + 1) == Lexing::TokenType::LeftParen
+            && (i == 0 || tokens.GetType(i - 1) != Lexing::TokenType::Type))
+            callees.push_back(Atom(tokens.GetValue(i)));
+    }
+
+    double build = Bench::Fastest(runs, [&]() {
+        SSA::Module module(argv[1]);
+        SSA::Builder builder(module);
+        for(Parsing::NodeRef node : ast.GetTopLevel())
+            ast.Emit(node, builder);
+    });
+    std::printf("%s: %zu functions, %zu calls, ssa build %.1f ms\n", argv[1], functions, callees.size(), build);
+
+    SSA::Module module(argv[1]);
+    SSA::Builder builder(module);
+    for(Parsing::NodeRef node : ast.GetTopLevel())
+        ast.Emit(node, builder);
+
+    // Scanning is quadratic in the function count, so it only resolves the
+    // calls of the first twentieth and tenth of the file
+    for(std::size_t count : { callees.size() / 20, callees.size() / 10, callees.size() })
+    {
+        std::size_t found = 0;
+        double indexed = Bench::Fastest(runs, [&]() {
+            found = 0;
+            for(std::size_t i = 0; i < count; ++i)
+                found += module.GetFunction(callees[i]) != nullptr;
+        });
+        std::printf("%8zu calls   name index %9.1f ms %7.1f ns/call", count, indexed, indexed * 1e6 / count);
+        if(count < callees.size())
+        {
+            double scanned = Bench::Fastest(1, [&]() {
+                std::size_t scanFound = 0;
+                for(std::size_t i = 0; i < count; ++i)
+                    scanFound += FindByScan(module, callees[i].GetName()) != nullptr;
+                if(scanFound != found)
+                    std::fprintf(stderr, "%s: lookups disagree\n", argv[0]);
+            });
+            std::printf("   global scan %9.1f ms %7.1f ns/call", scanned, scanned * 1e6 / count);
+        }
+        std::printf("\n");
+    }
+}
\ No newline at end of file
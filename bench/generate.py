@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+# Writes the generated inputs the benchmarks are run on
+import sys
+
+def functions(count):
+    out = []
+    for i in range(count):
+        out.append(
+            f"let int32 f{i}() = {{\n"
+            f"    let int32 a = {i % 1000};\n"
+            "    let int32 b = a * 3 + 7;\n"
+            "    return b - a;\n"
+            "}\n"
+        )
+    out.append("let int32 main() = {\n    return f0();\n}\n")
+    return "".join(out)
+
+def locals(count, perFunction=10):
+    # Names are unique across the file, so a lookup in one flat list of every
+    # declaration finds the right local but has to pass all earlier ones
+    out = []
+    for i in range(count):
+        out.append(f"let int32 f{i}() = {{\n")
+        for j in range(perFunction):
+            init = " + ".join(f"f{i}v{k}" for k in range(max(0, j - 3), j)) or str(j)
+            out.append(f"    let int32 f{i}v{j} = {init};\n")
+        out.append(f"    return f{i}v{perFunction - 1};\n}}\n")
+    out.append("let int32 main() = {\n    return f0();\n}\n")
+    return "".join(out)
+
+def calls(count):
+    out = ["let int32 f0() = 1;\n"]
+    for i in range(1, count):
+        out.append(f"let int32 f{i}() = f{i - 1}() + f{i // 2}();\n")
+    out.append(f"let int32 main() = f{count - 1}();\n")
+    return "".join(out)
+
+shapes = {
+    # Many small functions with a few locals each
+    "functions": functions,
+    # Ten locals per function, each reading the three before it
+    "locals": locals,
+    # Every function calls the one before it and the one at half its index
+    "calls": calls,
+}
+
+def main():
+    if len(sys.argv) != 4 or sys.argv[1] not in shapes:
+        sys.exit(f"usage: {sys.argv[0]} <{'|'.join(shapes)}> <count> <output file>")
+    with open(sys.argv[3], "w") as file:
+        file.write(shapes[sys.argv[1]](int(sys.argv[2])))
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file
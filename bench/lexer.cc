@@ -0,0 +1,83 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <source/sourceManager.hh>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// A token that owns a copy of its text, laid out like tokens were before they
+// became views into the source buffer
+struct OwningToken
+{
+    Lexing::TokenType type;
+    std::string text;
+    unsigned int start;
+    unsigned int end;
+    unsigned int line;
+    unsigned int column;
+    unsigned int length;
+};
+
+static void Report(const char* name, double time, Bench::Allocations allocations, std::size_t storage, std::size_t tokens, std::size_t bytes)
+{
+    std::printf("%-16s %8.1f ms %8.1f MB/s %10zu allocations %6.3f allocations/token %6.1f bytes/token\n",
+        name, time, bytes / time / 1e3, allocations.count,
+        double(allocations.count) / tokens, double(storage) / tokens);
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <file> [runs]\n", argv[0]);
+        return 1;
+    }
+    int runs = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+    std::size_t bytes = file->GetText().size();
+
+    Bench::Allocations before = Bench::CountAllocations();
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    Bench::Allocations viewAllocations = Bench::CountAllocations() - before;
+    std::size_t viewStorage = tokens.Size() * (sizeof(std::uint8_t) + 2 * sizeof(std::uint32_t) + sizeof(long long));
+
+    double viewTime = Bench::Fastest(runs, [file]() {
+        Lexing::Lexer(*file).Lex(1);
+    });
+
+    // Copies every token's text out of the buffer, one character at a time
+    // as the old lexer built it
+    auto lexOwning = [&tokens]() {
+        std::vector<OwningToken> owning;
+        for(std::size_t i = 0; i < tokens.Size(); ++i)
+        {
+            std::string text;
+            for(char c : tokens.GetText(i))
+                text += c;
+            unsigned int start = tokens.GetStart(i);
+            unsigned int length = tokens.GetLength(i);
+            owning.push_back({ tokens.GetType(i), std::move(text), start, start + length, 0, 0, length });
+        }
+        return owning;
+    };
+    before = Bench::CountAllocations();
+    std::vector<OwningToken> owning = lexOwning();
+    Bench::Allocations owningAllocations = Bench::CountAllocations() - before;
+    std::size_t owningStorage = owning.size() * sizeof(OwningToken);
+    for(const OwningToken& token : owning)
+        if(token.text.capacity() > std::string().capacity())
+            owningStorage += token.text.capacity() + 1;
+
+    double owningTime = viewTime + Bench::Fastest(runs, lexOwning);
+
+    std::printf("%s: %zu bytes, %zu tokens\n", argv[1], bytes, tokens.Size());
+    Report("view tokens", viewTime, viewAllocations, viewStorage, tokens.Size(), bytes);
+    Report("owning tokens", owningTime, owningAllocations, owningStorage, tokens.Size(), bytes);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <lexing/tokenStream.hh>
+#include <parsing/parser.hh>
+#include <source/sourceManager.hh>
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s <file> <functions> [jobs] [runs]\n", argv[0]);
+        return 1;
+    }
+    std::size_t functions = std::stoul(argv[2]);
+    unsigned int jobs = argc > 3 ? std::stoul(argv[3]) : 4;
+    int runs = argc > 4 ? std::stoi(argv[4]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    auto parse = [&](unsigned int threads) {
+        return Bench::Fastest(runs, [&]() {
+            Lexing::TokenStream stream(tokens);
+            Parsing::Parser parser(stream, *file);
+            parser.Parse(threads);
+        });
+    };
+    double sequential = parse(1);
+    double threaded = parse(jobs);
+
+    std::printf("%10zu functions %10zu tokens   parse -j1 %9.1f ms %7.1f ns/function   -j%u %9.1f ms %7.1f ns/function\n",
+        functions, tokens.Size(), sequential, sequential * 1e6 / functions, jobs, threaded, threaded * 1e6 / functions);
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <lexing/tokenStream.hh>
+#include <parsing/parser.hh>
+#include <source/sourceManager.hh>
+#include <ssa/pass/optimize.hh>
+#include <codegen/assembly.hh>
+#include <algorithm>
+#include <cstdio>
+#include <optional>
+#include <sstream>
+#include <string>
+
+struct Phases
+{
+    double build;
+    double passes;
+    double codegen;
+    double emit;
+    double teardown;
+    Bench::Allocations buildAllocations;
+    std::size_t arenaObjects;
+    std::size_t arenaBlocks;
+    std::size_t values;
+    std::size_t outputSize;
+};
+
+// Runs the back end like Compiler::Compile does, one function at a time.
+// Each phase's time is summed over the functions
+static Phases Compile(const std::string& id, const Parsing::AST& ast)
+{
+    Phases phases = {};
+    std::optional<SSA::Module> module(std::in_place, id);
+    SSA::Builder builder(*module);
+    Codegen::Assembly assembly;
+    std::ostringstream output;
+
+    for(Parsing::NodeRef node : ast.GetTopLevel())
+    {
+        Bench::Allocations allocations = Bench::CountAllocations();
+        Bench::Clock::time_point begin = Bench::Clock::now();
+        SSA::Value* value = ast.Emit(node, builder);
+        Bench::Clock::time_point built = Bench::Clock::now();
+        allocations = Bench::CountAllocations() - allocations;
+        phases.buildAllocations.count += allocations.count;
+        phases.buildAllocations.bytes += allocations.bytes;
+
+        if(SSA::Function* function = dynamic_cast<SSA::Function*>(value))
+            SSA::OptimizeFunction(*function);
+        Bench::Clock::time_point optimized = Bench::Clock::now();
+
+        value->Emit(assembly);
+        Bench::Clock::time_point generated = Bench::Clock::now();
+
+        phases.build += Bench::Milliseconds(begin, built);
+        phases.passes += Bench::Milliseconds(built, optimized);
+        phases.codegen += Bench::Milliseconds(optimized, generated);
+    }
+
+    Bench::Clock::time_point generated = Bench::Clock::now();
+    assembly.Emit(output);
+    phases.emit = Bench::Milliseconds(generated, Bench::Clock::now());
+    phases.values = module->GetValueCount();
+    phases.outputSize = output.str().size();
+    phases.arenaObjects = module->GetArena().GetObjectCount();
+    phases.arenaBlocks = module->GetArena().GetBlockCount();
+
+    Bench::Clock::time_point emitted = Bench::Clock::now();
+    module.reset();
+    phases.teardown = Bench::Milliseconds(emitted, Bench::Clock::now());
+    return phases;
+}
+
+static void Report(const char* name, double time, std::size_t values)
+{
+    std::printf("%-12s %9.1f ms %7.1f ns/value\n", name, time, time * 1e6 / values);
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <file> [runs]\n", argv[0]);
+        return 1;
+    }
+    int runs = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    Lexing::TokenStream stream(tokens);
+    Parsing::Parser parser(stream, *file);
+    Parsing::AST ast = parser.Parse(1);
+
+    // Keeps the fastest time of each phase separately
+    Phases fastest = Compile(argv[1], ast);
+    for(int i = 1; i < runs; ++i)
+    {
+        Phases phases = Compile(argv[1], ast);
+        if(phases.outputSize != fastest.outputSize)
+        {
+            std::fprintf(stderr, "%s: runs wrote different assembly\n", argv[0]);
+            return 1;
+        }
+        fastest.build = std::min(fastest.build, phases.build);
+        fastest.passes = std::min(fastest.passes, phases.passes);
+        fastest.codegen = std::min(fastest.codegen, phases.codegen);
+        fastest.emit = std::min(fastest.emit, phases.emit);
+        fastest.teardown = std::min(fastest.teardown, phases.teardown);
+    }
+
+    std::printf("%s: %zu SSA values, %zu bytes of assembly\n", argv[1], fastest.values, fastest.outputSize);
+    Report("ssa build", fastest.build, fastest.values);
+    Report("passes", fastest.passes, fastest.values);
+    Report("codegen", fastest.codegen, fastest.values);
+    Report("emit", fastest.emit, fastest.values);
+    Report("teardown", fastest.teardown, fastest.values);
+
+    // Without the arena each of its objects would be a heap allocation
+    std::printf("ssa build allocations: %zu on the heap (%zu bytes), %zu arena objects in %zu blocks\n",
+        fastest.buildAllocations.count, fastest.buildAllocations.bytes, fastest.arenaObjects, fastest.arenaBlocks);
+}
\ No newline at end of file
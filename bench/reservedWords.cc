@@ -0,0 +1,97 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <lexing/reservedWords.hh>
+#include <source/sourceManager.hh>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The lookups identifiers went through before the perfect hash: the type map
+// first, then the keyword map, each probed with a freshly built std::string
+static const std::map<std::string, std::shared_ptr<long long>> types = {
+    { "int8",  std::make_shared<long long>(8) },
+    { "int16", std::make_shared<long long>(16) },
+    { "int32", std::make_shared<long long>(32) },
+    { "int64", std::make_shared<long long>(64) },
+};
+
+static const std::unordered_map<std::string_view, Lexing::TokenType> keywords = {
+    { "return", Lexing::TokenType::Return },
+    { "let",    Lexing::TokenType::Let },
+};
+
+static long long ClassifyTwoMaps(std::string_view text)
+{
+    std::string value(text);
+    if(auto type = types.find(value); type != types.end())
+        return *type->second;
+    if(auto keyword = keywords.find(value); keyword != keywords.end())
+        return static_cast<long long>(keyword->second);
+    return -1;
+}
+
+static long long ClassifyPerfectHash(std::string_view text)
+{
+    if(const Lexing::ReservedWords::Entry* entry = Lexing::FindReservedWord(text))
+        return entry->type == Lexing::TokenType::Type ? entry->value : static_cast<long long>(entry->type);
+    return -1;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <file> [runs]\n", argv[0]);
+        return 1;
+    }
+    int runs = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    // Every span the lexer classifies: identifiers and reserved words alike
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    std::vector<std::string_view> words;
+    for(std::size_t i = 0; i < tokens.Size(); ++i)
+    {
+        Lexing::TokenType type = tokens.GetType(i);
+        if(type == Lexing::TokenType::Identifier || type == Lexing::TokenType::Return || type == Lexing::TokenType::Let || type == Lexing::TokenType::Type)
+            words.push_back(tokens.GetText(i));
+    }
+
+    long long twoMapSum = 0;
+    long long perfectHashSum = 0;
+    Bench::Allocations before = Bench::CountAllocations();
+    double twoMapTime = Bench::Fastest(runs, [&]() {
+        twoMapSum = 0;
+        for(std::string_view word : words)
+            twoMapSum += ClassifyTwoMaps(word);
+    });
+    Bench::Allocations twoMapAllocations = Bench::CountAllocations() - before;
+
+    before = Bench::CountAllocations();
+    double perfectHashTime = Bench::Fastest(runs, [&]() {
+        perfectHashSum = 0;
+        for(std::string_view word : words)
+            perfectHashSum += ClassifyPerfectHash(word);
+    });
+    Bench::Allocations perfectHashAllocations = Bench::CountAllocations() - before;
+
+    if(twoMapSum != perfectHashSum)
+    {
+        std::fprintf(stderr, "%s: lookups disagree (%lld and %lld)\n", argv[0], twoMapSum, perfectHashSum);
+        return 1;
+    }
+
+    std::printf("%s: %zu words\n", argv[1], words.size());
+    std::printf("%-16s %8.1f ms %6.1f ns/word %10zu allocations\n", "two maps", twoMapTime, twoMapTime * 1e6 / words.size(), twoMapAllocations.count / runs);
+    std::printf("%-16s %8.1f ms %6.1f ns/word %10zu allocations\n", "perfect hash", perfectHashTime, perfectHashTime * 1e6 / words.size(), perfectHashAllocations.count / runs);
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#!/bin/sh
+# Parses generated inputs of growing function counts, to show parse time
+# stays linear, and checks the compiler writes the same assembly with one
+# job, several jobs and streamed tokens
+# usage: scaling.sh <build directory> <jobs> <runs> <function count>...
+build=$1
+jobs=$2
+runs=$3
+shift 3
+for count in "$@"; do
+    input=$build/scaling.vpr
+    python3 $(dirname $0)/generate.py functions $count $input || exit 1
+    $build/parser $input $count $jobs $runs || exit 1
+    sequential=$($build/viper -j1 $input | cksum)
+    threaded=$($build/viper -j$jobs $input | cksum)
+    streamed=$($build/viper -j1 --stream-tokens $input | cksum)
+    if [ "$sequential" != "$threaded" ] || [ "$sequential" != "$streamed" ]; then
+        echo "$count functions: -j1, -j$jobs and --stream-tokens wrote different assembly"
+        exit 1
+    fi
+done
+rm -f $build/scaling.vpr
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <lexing/tokenStream.hh>
+#include <parsing/parser.hh>
+#include <source/sourceManager.hh>
+#include <symbol/symbolTable.hh>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// The symbol operations the parser makes, in the order it makes them
+struct Operation
+{
+    enum Kind { Function, PushScope, PopScope, Declare, Find } kind;
+    Atom name;
+};
+
+// The old global symbol list: every declaration of the file, searched from the
+// front by name and never emptied
+class GlobalSymbols
+{
+public:
+    void Declare(std::string_view name)
+    {
+        _symbols.push_back(std::make_unique<std::string>(name));
+    }
+
+    const std::string* Find(std::string_view name) const
+    {
+        auto it = std::find_if(_symbols.begin(), _symbols.end(), [name](const std::unique_ptr<std::string>& symbol) {
+            return *symbol == name;
+        });
+        return it != _symbols.end() ? it->get() : nullptr;
+    }
+
+private:
+    std::vector<std::unique_ptr<std::string>> _symbols;
+};
+
+static std::vector<Operation> RecordOperations(const Lexing::TokenList& tokens)
+{
+    std::vector<Operation> operations;
+    int depth = 0;
+    for(std::size_t i = 0; i + 1 < tokens.Size(); ++i)
+    {
+        switch(tokens.GetType(i))
+        {
+            case Lexing::TokenType::LeftBracket:
+                operations.push_back({ Operation::PushScope, Atom() });
+                ++depth;
+                break;
+            case Lexing::TokenType::RightBracket:
+                operations.push_back({ Operation::PopScope, Atom() });
+                --depth;
+                break;
+            case Lexing::TokenType::Let:
+                if(depth == 0)
+                    operations.push_back({ Operation::Function, Atom() });
+                break;
+            case Lexing::TokenType::Identifier:
+            {
+                Atom name(tokens.GetValue(i));
+                if(i > 0 && tokens.GetType(i - 1) == Lexing::TokenType::Type)
+                {
+                    if(depth > 0)
+                        operations.push_back({ Operation::Declare, name });
+                }
+                else if(tokens.GetType(i + 1) != Lexing::TokenType::LeftParen)
+                    operations.push_back({ Operation::Find, name });
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return operations;
+}
+
+// Replays the operations of the first given number of functions, returning
+// how many lookups found their symbol
+template<typename Table>
+static std::size_t Replay(const std::vector<Operation>& operations, std::size_t functions, Table& table)
+{
+    std::size_t found = 0;
+    std::size_t function = 0;
+    for(const Operation& operation : operations)
+    {
+        switch(operation.kind)
+        {
+            case Operation::Function:
+                if(function++ == functions)
+                    return found;
+                table.Function();
+                break;
+            case Operation::PushScope:
+                table.PushScope();
+                break;
+            case Operation::PopScope:
+                table.PopScope();
+                break;
+            case Operation::Declare:
+                table.Declare(operation.name);
+                break;
+            case Operation::Find:
+                found += table.Find(operation.name);
+                break;
+        }
+    }
+    return found;
+}
+
+struct ScopedReplay
+{
+    SymbolTable table;
+
+    void Function() { table.Reset(); }
+    void PushScope() { table.PushScope(); }
+    void PopScope() { table.PopScope(); }
+    void Declare(Atom name) { table.Declare(name, nullptr); }
+    bool Find(Atom name) { return table.Find(name) != nullptr; }
+};
+
+struct GlobalReplay
+{
+    GlobalSymbols symbols;
+
+    void Function() {}
+    void PushScope() {}
+    void PopScope() {}
+    void Declare(Atom name) { symbols.Declare(name.GetName()); }
+    bool Find(Atom name) { return symbols.Find(name.GetName()) != nullptr; }
+};
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s <file> <functions> [runs]\n", argv[0]);
+        return 1;
+    }
+    std::size_t functions = std::stoul(argv[2]);
+    int runs = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    std::vector<Operation> operations = RecordOperations(tokens);
+    std::size_t declarations = std::count_if(operations.begin(), operations.end(), [](const Operation& operation) {
+        return operation.kind == Operation::Declare;
+    });
+    std::printf("%s: %zu functions, %zu locals\n", argv[1], functions, declarations);
+
+    // The global list is quadratic in the function count, so it is only run
+    // on the first tenth and fifth of the file
+    for(std::size_t count : { functions / 10, functions / 5, functions })
+    {
+        std::size_t lookups = 0;
+        double scoped = Bench::Fastest(runs, [&]() {
+            ScopedReplay replay;
+            lookups = Replay(operations, count, replay);
+        });
+        std::printf("%8zu functions   scoped table %9.1f ms %7.1f ns/lookup", count, scoped, scoped * 1e6 / lookups);
+        if(count < functions)
+        {
+            double global = Bench::Fastest(1, [&]() {
+                GlobalReplay replay;
+                if(Replay(operations, count, replay) != lookups)
+                    std::fprintf(stderr, "%s: tables disagree\n", argv[0]);
+            });
+            std::printf("   global list %9.1f ms %7.1f ns/lookup", global, global * 1e6 / lookups);
+        }
+        std::printf("\n");
+    }
+
+    double parse = Bench::Fastest(runs, [&]() {
+        Lexing::TokenStream stream(tokens);
+        Parsing::Parser parser(stream, *file);
+        parser.Parse(1);
+    });
+    std::printf("parse %.1f ms\n", parse);
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <bench/bench.hh>
+#include <lexing/lexer.hh>
+#include <lexing/tokenStream.hh>
+#include <parsing/parser.hh>
+#include <source/sourceManager.hh>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// A token laid out like tokens were before the token list became parallel
+// arrays: the type, an owned copy of the text and five positions
+struct FatToken
+{
+    Lexing::TokenType type;
+    std::string text;
+    unsigned int start;
+    unsigned int end;
+    unsigned int line;
+    unsigned int column;
+    unsigned int length;
+};
+
+// The cursor the parser used over an array of structures, handing out
+// tokens by value
+class FatCursor
+{
+public:
+    FatCursor(const std::vector<FatToken>& tokens) : _tokens(tokens), _position(0) {}
+
+    FatToken Current() const { return _tokens[_position]; }
+    FatToken Peek(unsigned int offset) const { return _tokens[_position + offset]; }
+    FatToken Consume() { return _tokens[_position++]; }
+
+private:
+    const std::vector<FatToken>& _tokens;
+    std::size_t _position;
+};
+
+// What the parser does for every token: look at the current and the next
+// type, then consume the current token
+static std::size_t WalkFat(const std::vector<FatToken>& tokens)
+{
+    FatCursor cursor(tokens);
+    std::size_t count = 0;
+    while(cursor.Current().type != Lexing::TokenType::EndOfFile)
+    {
+        count += cursor.Peek(1).type == Lexing::TokenType::Semicolon;
+        cursor.Consume();
+    }
+    return count;
+}
+
+static std::size_t WalkStream(const Lexing::TokenList& tokens)
+{
+    Lexing::TokenStream stream(tokens);
+    std::size_t count = 0;
+    while(stream.CurrentType() != Lexing::TokenType::EndOfFile)
+    {
+        count += stream.PeekType(1) == Lexing::TokenType::Semicolon;
+        stream.Consume();
+    }
+    return count;
+}
+
+// The scan Parser::Parse(threads) makes to split the input at brace depth zero
+template<typename GetType>
+static std::size_t CountTopLevel(std::size_t size, GetType getType)
+{
+    std::size_t count = 0;
+    int depth = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        Lexing::TokenType type = getType(i);
+        depth += (type == Lexing::TokenType::LeftBracket) - (type == Lexing::TokenType::RightBracket);
+        count += depth == 0 && type == Lexing::TokenType::Semicolon;
+    }
+    return count;
+}
+
+static void Report(const char* name, double time, std::size_t tokens)
+{
+    std::printf("%-28s %8.1f ms %8.1f Mtokens/s\n", name, time, tokens / time / 1e3);
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <file> [runs]\n", argv[0]);
+        return 1;
+    }
+    int runs = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    SourceManager manager;
+    const SourceFile* file = manager.Load(argv[1]);
+    if(!file)
+    {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    Lexing::TokenList tokens = Lexing::Lexer(*file).Lex(1);
+    std::vector<FatToken> fatTokens;
+    fatTokens.reserve(tokens.Size());
+    for(std::size_t i = 0; i < tokens.Size(); ++i)
+    {
+        unsigned int start = tokens.GetStart(i);
+        unsigned int length = tokens.GetLength(i);
+        fatTokens.push_back({ tokens.GetType(i), std::string(tokens.GetText(i)), start, start + length, 0, 0, length });
+    }
+
+    std::size_t fatCount = 0;
+    std::size_t streamCount = 0;
+    double fatWalk = Bench::Fastest(runs, [&]() { fatCount = WalkFat(fatTokens); });
+    double streamWalk = Bench::Fastest(runs, [&]() { streamCount = WalkStream(tokens); });
+
+    std::size_t fatTopLevel = 0;
+    std::size_t listTopLevel = 0;
+    double fatScan = Bench::Fastest(runs, [&]() {
+        fatTopLevel = CountTopLevel(fatTokens.size(), [&fatTokens](std::size_t i) { return fatTokens[i].type; });
+    });
+    double listScan = Bench::Fastest(runs, [&]() {
+        listTopLevel = CountTopLevel(tokens.Size(), [&tokens](std::size_t i) { return tokens.GetType(i); });
+    });
+
+    if(fatCount != streamCount || fatTopLevel != listTopLevel)
+    {
+        std::fprintf(stderr, "%s: layouts disagree\n", argv[0]);
+        return 1;
+    }
+
+    double parse = Bench::Fastest(runs, [&]() {
+        Lexing::TokenStream stream(tokens);
+        Parsing::Parser parser(stream, *file);
+        parser.Parse(1);
+    });
+
+    std::printf("%s: %zu tokens, %zu and %zu bytes per token\n", argv[1], tokens.Size(),
+        sizeof(FatToken), sizeof(std::uint8_t) + 2 * sizeof(std::uint32_t) + sizeof(long long));
+    Report("cursor walk, structures", fatWalk, tokens.Size());
+    Report("cursor walk, token list", streamWalk, tokens.Size());
+    Report("type scan, structures", fatScan, tokens.Size());
+    Report("type scan, token list", listScan, tokens.Size());
+    Report("parse, token list", parse, tokens.Size());
+}
\ No newline at end of file
@@ -14,6 +14,8 @@ namespace Codegen
         Assembly();
 
         void Emit(std::ostream& stream);
+        // Adds the code emitted into other after the code emitted so far
+        void Append(const Assembly& other);
 
         void CreateGlobal(std::string_view ident);
         void CreateLabel(std::string_view label);
@@ -21,13 +23,20 @@ namespace Codegen
         void CreateJmp(std::string_view label);
     
         void CreatePush(Value* operand);
+        void CreatePop(Value* operand);
 
         void CreateMov(Value* left, Value*right);
+        // Moves the rightBits wide right operand into the leftBits wide
+        // register left, sign-extending it when it is narrower
+        void CreateMovsx(Value* left, Value* right, int leftBits, int rightBits);
 
         void CreateAdd(Value* left, Value* right);
         void CreateSub(Value* left, Value* right);
         void CreateMul(Value* left, Value* right);
-        void CreateDiv(Value* left, Value* right);
+        // Sign-extends the bits wide accumulator into rdx for CreateDiv
+        void CreateCqo(int bits);
+        // Divides rdx:rax by the bits wide divisor, leaving the quotient in rax
+        void CreateDiv(Value* divisor, int bits);
 
         void CreateCall(std::string_view label);
 
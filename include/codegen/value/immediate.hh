@@ -8,7 +8,7 @@ namespace Codegen
     class ImmediateValue : public Value
     {
     public:
-        ImmediateValue(long long value, std::shared_ptr<Type> type);
+        ImmediateValue(long long value, const Type* type);
 
         std::string Emit(int bits) override;
 
@@ -16,9 +16,13 @@ namespace Codegen
         bool RequiresSize() override;
 
         int GetSize() const override;
+
+        // Whether the value fits the sign-extended 32-bit immediate that
+        // every instruction but a mov to a register is limited to
+        bool FitsInt32() const;
     private:
         long long _value;
-        std::shared_ptr<Type> _type;
+        const Type* _type;
     };
 }
 
@@ -8,20 +8,18 @@ namespace Codegen
     class MemoryValue : public Value
     {
     public:
-        MemoryValue(int offset, bool isReference, std::shared_ptr<Type> type);
+        MemoryValue(int offset, bool isReference, const Type* type);
         MemoryValue(MemoryValue* other, bool isReference);
 
         std::string Emit(int bits) override;
 
         bool IsMemory() override;
 
-        void Dispose() override;
-
         int GetSize() const override;
     private:
         int _offset;
         bool _isReference;
-        std::shared_ptr<Type> _type;
+        const Type* _type;
     };
 }
 
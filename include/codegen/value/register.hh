@@ -1,6 +1,7 @@
 #ifndef VIPER_CODEGEN_REGISTER_HH
 #define VIPER_CODEGEN_REGISTER_HH
 #include <codegen/value/value.hh>
+#include <vector>
 
 namespace Codegen
 {
@@ -46,6 +47,8 @@ namespace Codegen
         Floating,
     };
 
+    class Assembly;
+
     class Register : public Value
     {
     public:
@@ -54,10 +57,27 @@ namespace Codegen
         std::string Emit(int bits) override;
         std::string_view GetID(int bits) const;
 
-        static Register* AllocRegister(RegisterType type);
+        // Registers are reference counted: AllocRegister and GetRegister hand
+        // out one reference and FreeRegister drops one. When every register
+        // is taken, AllocRegister spills a held one to the stack
+        static Register* AllocRegister(Assembly& assembly, RegisterType type);
         static void FreeRegister(Register* reg);
+        static void FreeAllRegisters();
         static Register* GetRegister(std::string_view id);
 
+        // Adds references for a value that several users will read
+        static void RetainRegister(Register* reg, unsigned int count);
+        static bool IsShared(Register* reg);
+        static unsigned int GetReferenceCount(Register* reg);
+        static std::vector<Register*> GetLiveRegisters(RegisterType type);
+
+        // Lets AllocRegister move *value to a stack slot, replacing *value
+        // with the slot. value holds *references references to it, or one
+        // if references is null, and is only spilled while the held values
+        // account for all of its register's references
+        static void Hold(Value** value, const unsigned int* references = nullptr);
+        static void Release(Value** value);
+
         bool IsRegister() override;
 
         void Dispose() override;
@@ -0,0 +1,27 @@
+#ifndef VIPER_CODEGEN_STACKSLOT_HH
+#define VIPER_CODEGEN_STACKSLOT_HH
+#include <codegen/value/memory.hh>
+
+namespace Codegen
+{
+    // A 64 bit slot below a function's locals holding a spilled register.
+    // Slots are reference counted like registers, and a slot nothing refers
+    // to anymore is reused by the next spill
+    class StackSlot : public MemoryValue
+    {
+    public:
+        static StackSlot* AllocSlot(unsigned int references);
+        // Starts a function whose locals take up offset bytes of its frame
+        static void FreeAllSlots(int offset);
+        // The bytes of the frame taken up by locals and slots
+        static int GetFrameSize();
+
+        void Dispose() override;
+    private:
+        StackSlot(int offset);
+
+        unsigned int _references;
+    };
+}
+
+#endif
\ No newline at end of file
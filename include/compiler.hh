@@ -1,7 +1,7 @@
 #ifndef VIPER_COMPILER_HH
 #define VIPER_COMPILER_HH
+#include <source/sourceManager.hh>
 #include <string>
-#include <fstream>
 
 enum class OutputType
 {
@@ -12,16 +12,21 @@ enum class OutputType
 class Compiler
 {
 public:
-    Compiler(OutputType outputType, const std::string& inputFileName);
+    // Streaming tokens lexes them on demand into a fixed-size window, which
+    // keeps lexer memory constant but lexes and parses on one thread
+    Compiler(OutputType outputType, const std::string& inputFileName, unsigned int jobs, bool streamTokens = false);
 
     void Compile();
 
 private:
     OutputType _outputType;
 
-    std::ifstream _inputHandle;
+    unsigned int _jobs;
+    bool _streamTokens;
+
     std::string _inputFileName;
-    std::string _contents;
+    SourceManager _sourceManager;
+    const SourceFile* _inputFile;
 };
 
 #endif
\ No newline at end of file
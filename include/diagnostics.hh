@@ -1,18 +1,17 @@
 #ifndef VIPER_DIAGNOSTICS_HH
 #define VIPER_DIAGNOSTICS_HH
+#include <cstdint>
 #include <string_view>
 
+class SourceFile;
+
 namespace Diagnostics
 {
     [[noreturn]] void FatalError(std::string_view sender, std::string_view message);
     [[noreturn]] void Error(std::string_view sender, std::string_view message);
     
-    [[noreturn]] void CompilerError(const unsigned int lineNumber, const unsigned int colNumber, 
-        std::string_view message,
-        const char* errorBegin, const char* errorEnd,
-        const char* lineBegin, const char* lineEnd);
-
-    void setFileName(std::string_view newFileName);
+    [[noreturn]] void CompilerError(const SourceFile& file, std::uint32_t errorBegin, std::uint32_t errorEnd,
+        std::string_view message);
 }
 
-#endif
\ No newline at end of file
+#endif
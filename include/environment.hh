@@ -1,10 +1,20 @@
 #ifndef VIPER_ENVIRONMENT_HH
 #define VIPER_ENVIRONMENT_HH
 #include <ssa/value/instruction/alloca.hh>
-#include <symbol/symbols.hh>
-#include <map>
+#include <cstdint>
+#include <vector>
 
-extern std::map<std::string, SSA::AllocaInst*> namedValues;
-extern std::vector<VarSymbol*> varSymbols;
+// The storage of each local of the function being emitted, indexed by the
+// local's symbol ID. Symbol IDs are dense within a function, so this is a
+// plain array that lives only as long as the function's emission
+class Environment
+{
+public:
+    void Bind(std::uint32_t symbolID, SSA::AllocaInst* alloca);
+    SSA::AllocaInst* Find(std::uint32_t symbolID) const;
 
-#endif
\ No newline at end of file
+private:
+    std::vector<SSA::AllocaInst*> _values;
+};
+
+#endif
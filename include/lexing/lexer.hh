@@ -1,31 +1,59 @@
 #ifndef VIPER_LEXER_HH
 #define VIPER_LEXER_HH
-#include <lexing/token.hh>
+#include <lexing/tokenList.hh>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+class SourceFile;
+
 namespace Lexing
 {
     class Lexer
     {
     public:
-        Lexer(const std::string& text);
+        Lexer(const SourceFile& file);
 
-        std::vector<Lexing::Token> Lex();
+        Lexing::TokenList Lex();
+        Lexing::TokenList Lex(unsigned int threadCount);
+        Lexing::Token Next();
     private:
-        std::string _text;
+        // Inputs are only split when every chunk gets at least this much text
+        static constexpr unsigned int MinChunkSize = 1 << 20;
+
+        struct Failure
+        {
+            unsigned int position;
+            std::string message;
+        };
+
+        struct Chunk
+        {
+            unsigned int begin;
+            unsigned int end;
+            unsigned int stop;
+            Lexing::TokenList tokens;
+            std::optional<Failure> failure;
+        };
+
+        const SourceFile& _file;
+        std::string_view _text;
         unsigned int _position;
-        unsigned int _lineNumber;
-        unsigned int _colNumber;
-        char* _lineBegin;
+        unsigned int _end;
+        bool _deferErrors;
 
         char Current() const;
         char Consume();
         char Peek(const int offset) const;
 
+        void LexRange(Lexing::TokenList& tokens, unsigned int end);
+        void LexChunk(Chunk& chunk, unsigned int begin) const;
+
         std::optional<Lexing::Token> NextToken();
+
+        [[noreturn]] void LexerError(std::string_view message);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,129 @@
+#ifndef VIPER_LEXING_RESERVED_WORDS_HH
+#define VIPER_LEXING_RESERVED_WORDS_HH
+#include <lexing/token.hh>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace Lexing
+{
+    struct ReservedWord
+    {
+        std::string_view text;
+        TokenType type;
+        long long value;
+    };
+
+    // Type names carry their bit width as the token's value
+    constexpr ReservedWord reservedWords[] = {
+        { "return", TokenType::Return, 0 },
+        { "let",    TokenType::Let,    0 },
+
+        { "int8",   TokenType::Type,   8 },
+        { "int16",  TokenType::Type,   16 },
+        { "int32",  TokenType::Type,   32 },
+        { "int64",  TokenType::Type,   64 },
+    };
+
+    namespace ReservedWords
+    {
+        constexpr unsigned int maxLength = 8;
+        constexpr unsigned int tableBits = 4;
+        constexpr unsigned int tableSize = 1 << tableBits;
+
+        struct Entry
+        {
+            char text[maxLength];
+            unsigned char length;
+            TokenType type;
+            long long value;
+        };
+
+        // Packs the length, the first two characters and the last character
+        constexpr std::uint32_t Key(const char* text, std::size_t length)
+        {
+            return static_cast<std::uint32_t>(length)
+                | static_cast<std::uint32_t>(static_cast<unsigned char>(text[0])) << 8
+                | static_cast<std::uint32_t>(static_cast<unsigned char>(text[length > 1])) << 16
+                | static_cast<std::uint32_t>(static_cast<unsigned char>(text[length - 1])) << 24;
+        }
+
+        constexpr unsigned int Slot(std::uint32_t key, std::uint32_t seed)
+        {
+            return (key * seed) >> (32 - tableBits);
+        }
+
+        constexpr bool IsPerfect(std::uint32_t seed)
+        {
+            bool used[tableSize] = {};
+            for(const ReservedWord& word : reservedWords)
+            {
+                unsigned int slot = Slot(Key(word.text.data(), word.text.length()), seed);
+                if(used[slot])
+                    return false;
+                used[slot] = true;
+            }
+            return true;
+        }
+
+        constexpr std::uint32_t FindSeed()
+        {
+            for(std::uint32_t seed = 0x9E3779B1; seed != 0x9E3779B1 + 0x100000; seed += 2)
+            {
+                if(IsPerfect(seed))
+                    return seed;
+            }
+            return 0;
+        }
+
+        constexpr std::uint32_t seed = FindSeed();
+        static_assert(seed != 0, "no perfect hash seed for reservedWords, widen Key or tableBits");
+
+        constexpr std::array<Entry, tableSize> MakeTable()
+        {
+            std::array<Entry, tableSize> table{};
+            for(const ReservedWord& word : reservedWords)
+            {
+                Entry& entry = table[Slot(Key(word.text.data(), word.text.length()), seed)];
+                for(std::size_t i = 0; i < word.text.length(); ++i)
+                    entry.text[i] = word.text[i];
+                entry.length = word.text.length();
+                entry.type = word.type;
+                entry.value = word.value;
+            }
+            return table;
+        }
+
+        constexpr std::array<Entry, tableSize> table = MakeTable();
+
+        constexpr bool FitsTable()
+        {
+            for(const ReservedWord& word : reservedWords)
+            {
+                if(word.text.empty() || word.text.length() > maxLength)
+                    return false;
+            }
+            return true;
+        }
+        static_assert(FitsTable(), "reserved words must be between 1 and maxLength characters");
+    }
+
+    // Returns the entry for a reserved word, or nullptr for a plain identifier
+    constexpr const ReservedWords::Entry* FindReservedWord(std::string_view text)
+    {
+        if(text.empty() || text.length() > ReservedWords::maxLength)
+            return nullptr;
+
+        const ReservedWords::Entry& entry = ReservedWords::table[ReservedWords::Slot(ReservedWords::Key(text.data(), text.length()), ReservedWords::seed)];
+        if(entry.length != text.length())
+            return nullptr;
+        for(std::size_t i = 0; i < text.length(); ++i)
+        {
+            if(entry.text[i] != text[i])
+                return nullptr;
+        }
+        return &entry;
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef VIPER_LEXING_SCAN_HH
+#define VIPER_LEXING_SCAN_HH
+#include <array>
+
+namespace Lexing
+{
+    enum CharClass : unsigned char
+    {
+        Whitespace      = 1 << 0,
+        Newline         = 1 << 1,
+        IdentifierStart = 1 << 2,
+        IdentifierPart  = 1 << 3,
+        Digit           = 1 << 4,
+    };
+
+    constexpr std::array<unsigned char, 256> MakeCharClasses()
+    {
+        std::array<unsigned char, 256> classes{};
+        classes[' ']  = Whitespace;
+        classes['\t'] = Whitespace;
+        classes['\r'] = Whitespace;
+        classes['\n'] = Whitespace | Newline;
+
+        for(int c = 'a'; c <= 'z'; c++)
+            classes[c] = IdentifierStart | IdentifierPart;
+        for(int c = 'A'; c <= 'Z'; c++)
+            classes[c] = IdentifierStart | IdentifierPart;
+        for(int c = '0'; c <= '9'; c++)
+            classes[c] = IdentifierPart | Digit;
+        classes['_'] = IdentifierStart | IdentifierPart;
+
+        return classes;
+    }
+
+    constexpr std::array<unsigned char, 256> charClasses = MakeCharClasses();
+
+    constexpr bool IsCharClass(char c, CharClass charClass)
+    {
+        return charClasses[static_cast<unsigned char>(c)] & charClass;
+    }
+
+    // Each scanner looks at [begin, end) and never reads past end.
+    // They use AVX2 when the CPU supports it, SSE2 otherwise, and fall
+    // back to walking charClasses on other targets.
+    namespace Scan
+    {
+        const char* SkipWhitespace(const char* begin, const char* end);
+        const char* SkipIdentifier(const char* begin, const char* end);
+
+        const char* FindNewline(const char* begin, const char* end);
+        const char* FindCommentEnd(const char* begin, const char* end);
+    }
+}
+
+#endif
@@ -1,11 +1,13 @@
 #ifndef VIPER_TOKEN_HH
 #define VIPER_TOKEN_HH
+#include <symbol/interner.hh>
 #include <string>
+#include <string_view>
 #include <ostream>
 
 namespace Lexing
 {
-    enum class TokenType
+    enum class TokenType : unsigned char
     {
         LeftParen, RightParen,
         LeftBracket, RightBracket,
@@ -33,35 +35,36 @@ namespace Lexing
         Hash,
 
         Semicolon, Comma,
+
+        EndOfFile,
     };
+    
+    // A view into the source buffer, which must outlive the token
     class Token
     {
     public:
-        Token(TokenType type, const std::string& text,
-        const unsigned int start, const unsigned int end,
-        const unsigned int lineNumber, const unsigned int colNumber);
+        Token();
+        Token(TokenType type, std::string_view text, const unsigned int start, long long value = 0);
 
         std::string TypeAsString() const;
 
         Lexing::TokenType GetType() const;
-        std::string GetText() const;
+        std::string_view GetText() const;
+        long long GetValue() const;
+        Atom GetAtom() const;
         
         unsigned int GetStart() const;
         unsigned int GetEnd() const;
-        unsigned int GetLine() const;
-        unsigned int GetCol() const;
 
         friend std::ostream& operator<<(std::ostream& stream, Lexing::Token token);
     private:
-        TokenType _type;
-        std::string _text;
+        std::string_view _text;
+        long long _value;
 
         unsigned int _start;
-        unsigned int _end;
 
-        unsigned int _lineNumber;
-        unsigned int _colNumber;
+        TokenType _type;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,78 @@
+#ifndef VIPER_LEXING_TOKEN_LIST_HH
+#define VIPER_LEXING_TOKEN_LIST_HH
+#include <lexing/token.hh>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Lexing
+{
+    // The lexed token stream stored as parallel arrays, so scanning token
+    // types touches one byte per token. Lexer::Lex ends it with an EndOfFile entry
+    class TokenList
+    {
+    public:
+        TokenList(std::string_view text);
+
+        void Append(const Token& token);
+        void Append(const TokenList& tokens);
+        void Reserve(std::size_t count);
+        // Empties the list but keeps its storage
+        void Clear();
+
+        std::size_t Size() const;
+
+        TokenType GetType(std::size_t index) const;
+        unsigned int GetStart(std::size_t index) const;
+        unsigned int GetLength(std::size_t index) const;
+        long long GetValue(std::size_t index) const;
+        std::string_view GetText(std::size_t index) const;
+
+        Token Get(std::size_t index) const;
+
+    private:
+        std::string_view _text;
+
+        std::vector<std::uint8_t> _types;
+        std::vector<std::uint32_t> _starts;
+        std::vector<std::uint32_t> _lengths;
+        std::vector<long long> _values;
+    };
+
+    inline std::size_t TokenList::Size() const
+    {
+        return _types.size();
+    }
+
+    inline TokenType TokenList::GetType(std::size_t index) const
+    {
+        return static_cast<TokenType>(_types[index]);
+    }
+
+    inline unsigned int TokenList::GetStart(std::size_t index) const
+    {
+        return _starts[index];
+    }
+
+    inline unsigned int TokenList::GetLength(std::size_t index) const
+    {
+        return _lengths[index];
+    }
+
+    inline long long TokenList::GetValue(std::size_t index) const
+    {
+        return _values[index];
+    }
+
+    inline std::string_view TokenList::GetText(std::size_t index) const
+    {
+        return _text.substr(_starts[index], _lengths[index]);
+    }
+
+    inline Token TokenList::Get(std::size_t index) const
+    {
+        return Token(GetType(index), GetText(index), _starts[index], _values[index]);
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef VIPER_LEXING_TOKEN_STREAM_HH
+#define VIPER_LEXING_TOKEN_STREAM_HH
+#include <lexing/tokenList.hh>
+#include <lexing/lexer.hh>
+
+namespace Lexing
+{
+    // A cursor over a borrowed token list, or over the range [begin, end) of
+    // it. The current and the last consumed token are kept materialised so
+    // callers can hold references to them until the next Consume();
+    // everything else is read from the list.
+    //
+    // A stream can instead lex on demand into a borrowed window, which is
+    // refilled a bounded chunk at a time as the stream moves on, so memory
+    // stays constant in the input size
+    class TokenStream
+    {
+    public:
+        TokenStream(const TokenList& tokens);
+        TokenStream(const TokenList& tokens, std::size_t begin, std::size_t end);
+        TokenStream(Lexer& lexer, TokenList& window);
+
+        // Whether the stream lexes on demand. The token list and indices
+        // into it then only cover the current window
+        bool IsLexing() const;
+        const TokenList& GetTokenList() const;
+        std::size_t GetIndex() const;
+
+        TokenType CurrentType() const;
+        TokenType PeekType(unsigned int offset) const;
+
+        const Token& Current() const;
+        Token Peek(unsigned int offset) const;
+        const Token& Consume();
+
+        // Makes an implicit ';' the current token, as if it followed the
+        // token just consumed. The token list itself is left untouched
+        void InsertTerminator();
+
+    private:
+        static constexpr std::size_t WindowSize = 4096;
+        // Refills the window before fewer tokens than this are left to read
+        static constexpr std::size_t Lookahead = 4;
+
+        const TokenList& _tokens;
+        TokenList* _window;
+        Lexer* _lexer;
+        std::size_t _index;
+        std::size_t _end;
+        bool _terminatorPending;
+
+        Token _current;
+        Token _previous;
+
+        std::size_t ListIndex(unsigned int offset) const;
+        Token Get(std::size_t index) const;
+        void Refill();
+    };
+
+    inline std::size_t TokenStream::ListIndex(unsigned int offset) const
+    {
+        std::size_t index = _index + offset - _terminatorPending;
+        return index < _end ? index : _end;
+    }
+
+    inline TokenType TokenStream::CurrentType() const
+    {
+        return _current.GetType();
+    }
+
+    inline TokenType TokenStream::PeekType(unsigned int offset) const
+    {
+        if(offset == 0)
+            return _current.GetType();
+        std::size_t index = ListIndex(offset);
+        return index < _end ? _tokens.GetType(index) : TokenType::EndOfFile;
+    }
+
+    inline const Token& TokenStream::Current() const
+    {
+        return _current;
+    }
+}
+
+#endif
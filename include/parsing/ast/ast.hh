@@ -9,5 +9,63 @@
 #include <parsing/ast/expression/binaryExpression.hh>
 #include <parsing/ast/expression/variable.hh>
 #include <parsing/ast/expression/call.hh>
+#include <array>
+#include <vector>
 
-#endif
\ No newline at end of file
+namespace Parsing
+{
+    // Owns every node parsed from one file. Nodes of each kind live in their
+    // own contiguous array and refer to each other through NodeRefs, so the
+    // whole tree is freed at once when the AST goes away
+    class AST
+    {
+    public:
+        NodeRef CreateIntegerLiteral(long long value);
+        NodeRef CreateBinaryExpression(NodeRef lhs, BinaryOperator op, NodeRef rhs);
+        NodeRef CreateVariable(Atom name, std::uint32_t symbolID, const Type* type);
+        NodeRef CreateCall(Atom callee);
+        NodeRef CreateReturnStatement(NodeRef value, const Type* returnType);
+        NodeRef CreateCompoundStatement(const NodeRef* statements, std::uint32_t count);
+        NodeRef CreateVariableDeclaration(Atom name, std::uint32_t symbolID, const Type* type, NodeRef initVal, bool isFunction);
+
+        const IntegerLiteral& GetIntegerLiteral(NodeRef node) const;
+        const BinaryExpression& GetBinaryExpression(NodeRef node) const;
+        const Variable& GetVariable(NodeRef node) const;
+        const CallExpr& GetCall(NodeRef node) const;
+        const ReturnStatement& GetReturnStatement(NodeRef node) const;
+        const CompoundStatement& GetCompoundStatement(NodeRef node) const;
+        const VariableDeclaration& GetVariableDeclaration(NodeRef node) const;
+
+        NodeRef GetStatement(std::uint32_t index) const;
+
+        void AddTopLevel(NodeRef node);
+
+        // Moves all of other's nodes after this AST's own, top-level
+        // declarations included
+        void Append(AST&& other);
+        const std::vector<NodeRef>& GetTopLevel() const;
+
+        void Print(NodeRef node, std::ostream& stream, int indent) const;
+        SSA::Value* Emit(NodeRef node, SSA::Builder& builder) const;
+
+    private:
+        std::vector<IntegerLiteral> _integerLiterals;
+        std::vector<BinaryExpression> _binaryExpressions;
+        std::vector<Variable> _variables;
+        std::vector<CallExpr> _calls;
+        std::vector<ReturnStatement> _returnStatements;
+        std::vector<CompoundStatement> _compoundStatements;
+        std::vector<VariableDeclaration> _variableDeclarations;
+
+        std::vector<NodeRef> _statements;
+        std::vector<NodeRef> _topLevel;
+
+        template<typename T>
+        NodeRef Append(std::vector<T>& nodes, ASTNodeType type, T node);
+
+        template<typename T>
+        static std::uint32_t Extend(std::vector<T>& nodes, std::vector<T>& other);
+    };
+}
+
+#endif
@@ -2,16 +2,18 @@
 #define VIPER_AST_ASTNODE_HH
 #include <ssa/ssa.hh>
 #include <type/types.hh>
+#include <cstdint>
 #include <ostream>
 
 namespace Parsing
 {
-    enum class ASTNodeType
+    enum class ASTNodeType : std::uint8_t
     {
         Integer,
         BinaryExpression,
 
         Variable,
+        Call,
 
         ReturnStatement,
         CompoundStatement,
@@ -20,22 +22,28 @@ namespace Parsing
         Function,
     };
 
-    class ASTNode
+    class AST;
+
+    // A 32-bit handle to a node in an AST: the node kind in the top bits
+    // and the index into that kind's array in the rest
+    class NodeRef
     {
     public:
-        ASTNode(ASTNodeType type) :_nodeType(type) {  }
-        virtual ~ASTNode() {  }
+        static constexpr unsigned int IndexBits = 28;
+        static constexpr std::uint32_t MaxIndex = (1u << IndexBits) - 1;
 
-        virtual void Print(std::ostream& stream, int indent) const = 0;
+        constexpr NodeRef() : _value(UINT32_MAX) {  }
+        constexpr NodeRef(ASTNodeType type, std::uint32_t index) : _value(static_cast<std::uint32_t>(type) << IndexBits | index) {  }
 
-        ASTNodeType GetNodeType() const { return _nodeType; }
-        std::shared_ptr<Type> GetType() const { return _type; }
+        constexpr ASTNodeType GetNodeType() const { return static_cast<ASTNodeType>(_value >> IndexBits); }
+        constexpr std::uint32_t GetIndex() const { return _value & MaxIndex; }
+        constexpr bool IsNull() const { return _value == UINT32_MAX; }
 
-        virtual SSA::Value* Emit(SSA::Builder& builder) = 0;
-    protected:
-        ASTNodeType _nodeType;
-        std::shared_ptr<Type> _type;
+        constexpr bool operator==(NodeRef other) const { return _value == other._value; }
+        constexpr bool operator!=(NodeRef other) const { return _value != other._value; }
+    private:
+        std::uint32_t _value;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
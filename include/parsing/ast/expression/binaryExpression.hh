@@ -5,7 +5,7 @@
 
 namespace Parsing
 {
-    enum class BinaryOperator
+    enum class BinaryOperator : std::uint8_t
     {
         Addition, Subtraction,
         Multiplication, Division,
@@ -13,21 +13,21 @@ namespace Parsing
         Assignment,
     };
 
-    class BinaryExpression : public ASTNode
+    BinaryOperator GetBinaryOperator(Lexing::TokenType type);
+
+    struct BinaryExpression
     {
-    public:
-        BinaryExpression(std::unique_ptr<ASTNode> lhs, Lexing::Token op, std::unique_ptr<ASTNode> rhs);
+        NodeRef lhs;
+        NodeRef rhs;
+        BinaryOperator op;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent) const;
 
-        SSA::Value* Emit(SSA::Builder& builder) override;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder) const;
     private:
-        std::unique_ptr<ASTNode>_lhs;
-        BinaryOperator _operator;
-        std::unique_ptr<ASTNode> _rhs;
-
         std::string OperatorToString() const;
+        SSA::Value* EmitOperation(SSA::Builder& builder, SSA::Value* left, SSA::Value* right) const;
     };
 }
 
-#endif  
\ No newline at end of file
+#endif
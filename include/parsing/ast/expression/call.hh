@@ -1,20 +1,18 @@
 #ifndef VIPER_AST_EXPRESSION_CALL_HH
 #define VIPER_AST_EXPRESSION_CALL_HH
 #include <parsing/ast/astNode.hh>
+#include <symbol/interner.hh>
 
 namespace Parsing
 {
-    class CallExpr : public ASTNode
+    struct CallExpr
     {
-    public:
-        CallExpr(const std::string& callee);
+        Atom callee;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent) const;
 
-        SSA::Value* Emit(SSA::Builder& builder) override;
-    private:
-        std::string _callee;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder) const;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -4,19 +4,14 @@
 
 namespace Parsing
 {
-    class IntegerLiteral : public ASTNode
+    struct IntegerLiteral
     {
-    public:
-        IntegerLiteral(long long value);
+        long long value;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent) const;
 
-        long long GetValue() const;
-
-        SSA::Value* Emit(SSA::Builder& builder) override;
-    private:
-        long long _value;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder) const;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
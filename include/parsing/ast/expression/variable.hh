@@ -1,22 +1,20 @@
 #ifndef VIPER_AST_EXPRESSION_VARIABLE_HH
 #define VIPER_AST_EXPRESSION_VARIABLE_HH
 #include <parsing/ast/astNode.hh>
+#include <symbol/interner.hh>
 
 namespace Parsing
 {
-    class Variable : public ASTNode
+    struct Variable
     {
-    public:
-        Variable(std::string name, std::shared_ptr<Type> type);
+        Atom name;
+        std::uint32_t symbolID;
+        const Type* type;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent) const;
 
-        SSA::Value* Emit(SSA::Builder& builder) override;
-
-        std::string GetName() const;
-    private:
-        std::string _name;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder) const;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,22 +1,19 @@
 #ifndef VIPER_AST_STATEMENT_COMPOUND_HH
 #define VIPER_AST_STATEMENT_COMPOUND_HH
 #include <parsing/ast/astNode.hh>
-#include <memory>
-#include <vector>
 
 namespace Parsing
 {
-    class CompoundStatement : public ASTNode
+    // The statements are stored contiguously in the AST's statement list
+    struct CompoundStatement
     {
-    public:
-        CompoundStatement(std::vector<std::unique_ptr<ASTNode>>& statements);
+        std::uint32_t first;
+        std::uint32_t count;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent) const;
 
-        SSA::Value* Emit(SSA::Builder& builder) override;
-    private:
-        std::vector<std::unique_ptr<ASTNode>> _statements;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder) const;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,24 +1,18 @@
 #ifndef VIPER_AST_STATEMENT_RETURN_HH
 #define VIPER_AST_STATEMENT_RETURN_HH
 #include <parsing/ast/astNode.hh>
-#include <memory>
 
 namespace Parsing
 {
-    class ReturnStatement : public ASTNode
+    struct ReturnStatement
     {
-    public:
-        ReturnStatement(std::unique_ptr<ASTNode> value, std::shared_ptr<Type> returnType);
+        NodeRef value;
+        const Type* returnType;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent) const;
 
-        std::shared_ptr<Type> GetReturnType() const;
-
-        SSA::Value* Emit(SSA::Builder& builder) override;
-    private:
-        std::unique_ptr<ASTNode> _value;
-        std::shared_ptr<Type> _returnType;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder) const;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
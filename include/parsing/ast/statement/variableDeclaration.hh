@@ -1,27 +1,23 @@
 #ifndef VIPER_AST_STATEMENT_VARIABLE_DELCARATION_HH
 #define VIPER_AST_STATEMENT_VARIABLE_DELCARATION_HH
 #include <parsing/ast/astNode.hh>
-#include <string>
-#include <vector>
-#include <memory>
+#include <symbol/interner.hh>
 
 namespace Parsing
 {
-    class VariableDeclaration : public ASTNode
+    // Shared by variables and functions; the NodeRef's type tells them apart.
+    // symbolID is only meaningful for variables
+    struct VariableDeclaration
     {
-    public:
-        VariableDeclaration(const std::string& name, std::shared_ptr<Type> type, std::unique_ptr<ASTNode> initVal, bool isFunction = false);
+        Atom name;
+        std::uint32_t symbolID;
+        const Type* type;
+        NodeRef initVal;
 
-        void Print(std::ostream& stream, int indent) const override;
+        void Print(const AST& ast, std::ostream& stream, int indent, bool isFunction) const;
 
-        bool IsFunction() const;
-        
-        SSA::Value* Emit(SSA::Builder& builder) override;
-    private:
-        std::string _name;
-        std::unique_ptr<ASTNode> _initVal;
-        bool _isFunction;
+        SSA::Value* Emit(const AST& ast, SSA::Builder& builder, bool isFunction) const;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,7 +1,9 @@
 #ifndef VIPER_PARSER_HH
 #define VIPER_PARSER_HH
 #include <parsing/ast/ast.hh>
-#include <lexing/token.hh>
+#include <lexing/tokenStream.hh>
+#include <source/sourceFile.hh>
+#include <symbol/symbolTable.hh>
 #include <vector>
 
 namespace Parsing
@@ -9,41 +11,64 @@ namespace Parsing
     class Parser
     {
     public:
-        Parser(const std::vector<Lexing::Token>& tokens, const std::string& text);
+        Parser(Lexing::TokenStream& tokens, const SourceFile& file);
 
-        std::vector<std::unique_ptr<ASTNode>> Parse();
+        AST Parse();
+        AST Parse(unsigned int threadCount);
     private:
-        std::string _text;
-        std::vector<Lexing::Token> _tokens;
-        unsigned int _position;
-        std::shared_ptr<Type> _currentReturnType;
+        // Declarations are only parsed in parallel when each chunk of them
+        // gets at least this many tokens
+        static constexpr std::size_t MinChunkTokens = 1 << 14;
 
-        Lexing::Token Current() const;
-        Lexing::Token Consume();
+        struct Failure {};
+
+        const SourceFile& _file;
+        Lexing::TokenStream& _tokens;
+        const Type* _currentReturnType;
+        bool _deferErrors;
+
+        // Symbols declared by the current top-level declaration
+        SymbolTable _symbols;
+
+        struct PendingOperator
+        {
+            BinaryOperator op;
+            int precedence; // 0 marks an open parenthesis
+        };
+
+        AST _ast;
+        std::vector<NodeRef> _operands;
+        std::vector<PendingOperator> _operators;
+        std::vector<NodeRef> _statements;
+
+        const Lexing::Token& Current() const;
+        const Lexing::Token& Consume();
         Lexing::Token Peek(const int offset) const;
+        Lexing::TokenType CurrentType() const;
+        Lexing::TokenType PeekType(const int offset) const;
 
         int GetBinOpPrecedence(Lexing::TokenType type);
 
         void ExpectToken(Lexing::TokenType tokenType);
         [[noreturn]] void ParserError(std::string message);
+        [[noreturn]] void ParserError(std::string message, const Lexing::Token& token);
         
-        std::shared_ptr<Type> ParseType();
+        const Type* ParseType();
 
-        std::unique_ptr<ASTNode> ParseExpression(int precedence = 1);
-        std::unique_ptr<ASTNode> ParsePrimary();
-        std::unique_ptr<ASTNode> ParseIdentifier();
+        NodeRef ParseExpression();
+        NodeRef ParsePrimary();
+        NodeRef ParseIdentifier();
 
-        std::unique_ptr<ASTNode> ParseVariableDeclaration();
-        std::unique_ptr<ASTNode> ParseVariable();
+        NodeRef ParseVariableDeclaration();
+        NodeRef ParseVariable();
 
-        std::unique_ptr<ASTNode> ParseCallExpression();
+        NodeRef ParseCallExpression();
 
-        std::unique_ptr<ASTNode> ParseIntegerLiteral();
+        NodeRef ParseIntegerLiteral();
 
-        std::unique_ptr<ASTNode> ParseReturnStatement();
+        NodeRef ParseReturnStatement();
 
-        std::unique_ptr<ASTNode> ParseParenthesizedExpression();
-        std::unique_ptr<ASTNode> ParseCompoundExpression();
+        NodeRef ParseCompoundExpression();
     };
 }
 
@@ -0,0 +1,28 @@
+#ifndef VIPER_SOURCE_FILE_HH
+#define VIPER_SOURCE_FILE_HH
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Positions in a file are 32-bit byte offsets. Lines and columns are
+// only worked out from the line table when a diagnostic needs them.
+class SourceFile
+{
+public:
+    SourceFile(const std::string& name, std::string_view text);
+
+    std::string_view GetName() const;
+    std::string_view GetText() const;
+
+    unsigned int GetLine(std::uint32_t offset) const;
+    unsigned int GetColumn(std::uint32_t offset) const;
+    std::string_view GetLineText(unsigned int line) const;
+
+private:
+    std::string _name;
+    std::string_view _text;
+    std::vector<std::uint32_t> _lineOffsets;
+};
+
+#endif
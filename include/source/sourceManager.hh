@@ -0,0 +1,33 @@
+#ifndef VIPER_SOURCE_MANAGER_HH
+#define VIPER_SOURCE_MANAGER_HH
+#include <source/sourceFile.hh>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Owns every input buffer. Files are mapped read-only and shared by
+// the lexer, parser and diagnostics without being copied.
+class SourceManager
+{
+public:
+    SourceManager() = default;
+    ~SourceManager();
+
+    SourceManager(const SourceManager&) = delete;
+    SourceManager& operator=(const SourceManager&) = delete;
+
+    const SourceFile* Load(const std::string& fileName);
+
+private:
+    struct Mapping
+    {
+        void* address;
+        std::size_t size;
+    };
+
+    std::vector<std::unique_ptr<SourceFile>> _files;
+    std::vector<Mapping> _mappings;
+    std::vector<std::unique_ptr<std::string>> _buffers;
+};
+
+#endif
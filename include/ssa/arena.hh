@@ -0,0 +1,60 @@
+#ifndef VIPER_SSA_ARENA_HH
+#define VIPER_SSA_ARENA_HH
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SSA
+{
+    // Bump allocator that owns the values of a module. Objects are never
+    // destroyed: everything placed in it is trivially destructible, so when
+    // the arena goes away its blocks are simply released together
+    class Arena
+    {
+    public:
+        Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        template<typename T, typename... Args>
+        T* Create(Args&&... args);
+
+        template<typename T>
+        T* CreateArray(std::size_t count);
+
+        std::size_t GetObjectCount() const;
+        std::size_t GetBlockCount() const;
+
+    private:
+        static constexpr std::size_t BlockSize = 64 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        char* _position;
+        std::size_t _left;
+        std::size_t _objectCount;
+
+        void* Allocate(std::size_t size, std::size_t alignment);
+    };
+
+    template<typename T, typename... Args>
+    T* Arena::Create(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        return new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* Arena::CreateArray(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena arrays are never destroyed");
+        T* array = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        for(std::size_t i = 0; i < count; ++i)
+            new(array + i) T();
+        return array;
+    }
+}
+
+#endif
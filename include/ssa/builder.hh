@@ -12,6 +12,9 @@
 #include <ssa/value/instruction/binOp.hh>
 #include <ssa/value/basicBlock.hh>
 #include <ssa/value/instruction/call.hh>
+#include <ssa/value/instruction/cast.hh>
+
+class Environment;
 
 namespace SSA
 {
@@ -23,20 +26,33 @@ namespace SSA
         void SetInsertPoint(BasicBlock* insertPoint);
         BasicBlock* GetInsertPoint() const;
 
+        // The locals of the function currently being emitted
+        void SetEnvironment(Environment* environment);
+        Environment& GetEnvironment() const;
+
         Value* CreateRet(Value* value);
 
         Value* CreateConstantInt(long long value);
+        Value* CreateConstantInt(long long value, const Type* type);
 
+        // Operations are folded and simplified as they are created, so these
+        // only return a new instruction when nothing simpler computes the
+        // same value
         Value* CreateAdd(Value* lhs, Value* rhs);
         Value* CreateSub(Value* lhs, Value* rhs);
         Value* CreateMul(Value* lhs, Value* rhs);
         Value* CreateDiv(Value* lhs, Value* rhs);
 
-        CallInst* CreateCall(Function* callee, const std::string& name = "");
+        CallInst* CreateCall(Function* callee);
+
+        // Returns value converted to type, folding a constant
+        Value* CreateCast(Value* value, const Type* type);
 
-        AllocaInst* CreateAlloca(std::shared_ptr<Type> allocatedType, const std::string& name = "");
+        AllocaInst* CreateAlloca(const Type* allocatedType);
+        // A value stored to a local is converted to the local's type first,
+        // so a later load of it can be replaced with the stored value
         StoreInst* CreateStore(Value* ptr, Value* value);
-        LoadInst* CreateLoad(Value* ptr, const std::string& name = "");
+        LoadInst* CreateLoad(Value* ptr);
 
         Module& GetModule() const;
     private:
@@ -44,6 +60,7 @@ namespace SSA
 
         Module& _module;
         BasicBlock* _insertPoint;
+        Environment* _environment;
     };
 }
 
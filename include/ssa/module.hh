@@ -1,27 +1,51 @@
 #ifndef VIPER_SSA_MODULE_HH
 #define VIPER_SSA_MODULE_HH
+#include <ssa/arena.hh>
+#include <symbol/interner.hh>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
+class Type;
+
 namespace SSA
 {
     class Value;
     class Function;
+    class IntegerLiteral;
     class Module
     {
     public:
         Module(const std::string& id);
         ~Module();
 
-        int GetNextInstName();
+        // Every value of the module but its functions is created in, and
+        // owned by, this arena
+        Arena& GetArena();
+
+        std::uint32_t NextValueID();
+        std::uint32_t GetValueCount() const;
 
         std::vector<Value*>& GetGlobals();
-        Function* GetFunction(std::string_view name) const;
+        const std::vector<Function*>& GetFunctions() const;
+
+        // Registers a new function as a global and takes ownership of it. The
+        // first function with a given name is the one GetFunction() finds
+        void AddFunction(Function* function);
+        Function* GetFunction(Atom name) const;
+
+        // Returns the module's one literal of the given type and value
+        IntegerLiteral* GetConstantInt(long long value, const Type* type);
     private:
+        Arena _arena;
         std::vector<Value*> _globals;
+        std::vector<Function*> _functions;
+        std::unordered_map<Atom, Function*> _functionIndex;
+        std::unordered_map<const Type*, std::unordered_map<long long, IntegerLiteral*>> _constants;
         std::string _id;
-        int _instNameCount;
+        std::uint32_t _valueCount;
     };
 };
 
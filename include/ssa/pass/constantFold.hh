@@ -0,0 +1,31 @@
+#ifndef VIPER_SSA_PASS_CONSTANT_FOLD_HH
+#define VIPER_SSA_PASS_CONSTANT_FOLD_HH
+#include <ssa/value/global/function.hh>
+
+namespace SSA
+{
+    // Computes lhs op rhs as an integer of the given type, wrapping around
+    // on overflow like the generated code does. Returns false when the
+    // result is undefined, as for a division by zero
+    bool FoldBinOp(Instruction::InstType op, long long lhs, long long rhs, const Type* type, long long& result);
+
+    // Wraps value around to an integer of the given type
+    long long WrapConstant(long long value, const Type* type);
+
+    // Returns what lhs op rhs can be replaced with without a new
+    // instruction, either a constant or one of the operands, or nullptr
+    Value* SimplifyBinOp(Instruction::InstType op, Value* lhs, Value* rhs, const Type* type);
+
+    // Moves the constant of a commutative operation to the right, merges
+    // (x op c1) op c2 into x op c3 and picks between x + c and x - c so
+    // that c is positive. Returns whether the operation or an operand
+    // changed
+    bool CanonicalizeBinOp(Instruction::InstType& op, Value*& lhs, Value*& rhs, const Type* type);
+
+    // Folds operations on constants and applies algebraic identities such
+    // as x + 0 and x - x. Simplifying an instruction requeues its users, so
+    // simplifications cascade up the expression
+    void FoldConstants(Function& function);
+}
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef VIPER_SSA_PASS_DEAD_CODE_HH
+#define VIPER_SSA_PASS_DEAD_CODE_HH
+#include <ssa/value/global/function.hh>
+
+namespace SSA
+{
+    // Removes the instructions after each block's return, values nothing
+    // uses, and stores to stack slots that are overwritten or never read.
+    // A load that follows a store to the same slot in a block reads the
+    // stored value directly
+    void EliminateDeadCode(Function& function);
+}
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef VIPER_SSA_PASS_MEM2REG_HH
+#define VIPER_SSA_PASS_MEM2REG_HH
+#include <ssa/value/global/function.hh>
+
+namespace SSA
+{
+    // Replaces the locals of a function that are only ever loaded from and
+    // stored to with the values stored to them, so they no longer need a
+    // stack slot. Only single-block functions are promoted: merging the
+    // values of several predecessors needs phis
+    void PromoteAllocas(Function& function);
+}
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef VIPER_SSA_PASS_OPTIMIZE_HH
+#define VIPER_SSA_PASS_OPTIMIZE_HH
+#include <ssa/value/global/function.hh>
+
+namespace SSA
+{
+    // Runs every pass over function, in order. The passes size their tables
+    // by the values created after the function, so this has to run before
+    // the next function is built
+    void OptimizeFunction(Function& function);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef VIPER_SSA_PASS_REASSOCIATE_HH
+#define VIPER_SSA_PASS_REASSOCIATE_HH
+#include <ssa/value/global/function.hh>
+
+namespace SSA
+{
+    // Flattens trees of the same associative operation, folds all of their
+    // constants into one and rebuilds them balanced, with the constant
+    // applied last. a + 1 + b + 2 becomes (a + b) + 3
+    void Reassociate(Function& function);
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef VIPER_SSA_PASS_VALUE_NUMBERING_HH
+#define VIPER_SSA_PASS_VALUE_NUMBERING_HH
+#include <ssa/value/global/function.hh>
+
+namespace SSA
+{
+    // Replaces each operation that computes the same as an earlier one,
+    // with commutative operands in either order, and each load of a slot
+    // that was not stored to since an earlier load of it, with that
+    // earlier value. Numbers are scoped to a block; once blocks have
+    // dominators, a block's scope nests inside its dominator's
+    void NumberValues(Function& function);
+}
+
+#endif
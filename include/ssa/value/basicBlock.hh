@@ -2,7 +2,6 @@
 #define VIPER_SSA_BASIC_BLOCK_HH
 #include <ssa/value/value.hh>
 #include <ssa/value/instruction/instruction.hh>
-#include <vector>
 #include <memory>
 
 namespace SSA
@@ -10,26 +9,30 @@ namespace SSA
     class Function;
     class BasicBlock : public Value
     {
+    friend class Arena;
     public:
-        static BasicBlock* Create(Module& module, Function* parent, const std::string& name = "");
+        static BasicBlock* Create(Module& module, Function* parent);
 
         Function* GetParent() const;
-        std::vector<Instruction*>& GetInstList();
+
+        Instruction* GetFirst() const;
+        Instruction* GetLast() const;
+
+        void Append(Instruction* inst);
+        void InsertBefore(Instruction* inst, Instruction* before);
+        void Remove(Instruction* inst);
 
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
-
     protected:
-        BasicBlock(Module& module, Function* parent, const std::string& name = "");
+        BasicBlock(Module& module, Function* parent);
         
     private:
-        std::string _name;
         Function* _parent;
-        std::vector<Instruction*> _instList;
+        Instruction* _first;
+        Instruction* _last;
     };
 }
 
@@ -4,17 +4,22 @@
 
 namespace SSA
 {
+    // Integer constants are uniqued by their module, so two literals with
+    // the same type and value are the same value
     class IntegerLiteral : public Value
     {
+    friend class Arena;
     public:
-        IntegerLiteral(Module& module, long long value);
-
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
+        void PrintID(std::ostream& stream) const override;
 
         long long GetValue() const;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
+
+    protected:
+        IntegerLiteral(Module& module, long long value, const Type* type);
+
     private:
         long long _value;
     };
@@ -3,31 +3,44 @@
 #include <ssa/value/value.hh>
 #include <ssa/value/basicBlock.hh>
 #include <ssa/value/instruction/alloca.hh>
+#include <symbol/interner.hh>
 #include <memory>
 
 namespace SSA
 {
-    class Function : public Value
+    // A function's block and alloca lists grow, so unlike the other values
+    // it is allocated on its own and owned by its module
+    class Function final : public Value
     {
     public:
-        static Function* Create(Module& module, const std::string& name);
+        static Function* Create(Module& module, Atom name);
 
         std::vector<BasicBlock*>& GetBasicBlockList();
         std::vector<AllocaInst*>& GetAllocaList();
 
+        // Every instruction the blocks reach through their operands, with
+        // operands before their users
+        std::vector<Instruction*> GetInstructionsInPostOrder();
+
+        // Every instruction of a function is created after the function
+        // itself, so counting IDs from the function's own gives passes dense
+        // side tables that do not grow with the rest of the module. Constants
+        // are shared by the module and may be older, so they have no local ID
+        std::uint32_t GetLocalValueCount() const;
+        std::uint32_t GetLocalID(const Value* value) const;
+
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
+        void PrintID(std::ostream& stream) const override;
         std::string_view GetName() const;
+        Atom GetAtom() const;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
-
     protected:
-        Function(Module& module, const std::string& name);
+        Function(Module& module, Atom name);
 
     private:
-        std::string _name;
+        Atom _name;
         int _totalAllocaOffset;
         std::vector<BasicBlock*> _basicBlockList;
         std::vector<AllocaInst*> _allocaList;
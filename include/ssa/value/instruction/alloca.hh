@@ -1,33 +1,33 @@
 #ifndef VIPER_SSA_INSTRUCTION_ALLOCA_HH
 #define VIPER_SSA_INSTRUCTION_ALLOCA_HH
 #include <ssa/value/instruction/instruction.hh>
-#include <ssa/value/tmpValue.hh>
 #include <memory>
 
 namespace SSA
 {
     class AllocaInst : public Instruction
     {
+    friend class Arena;
     friend class Builder;
     friend class Function;
     public:
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
+        void PrintID(std::ostream& stream) const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
+        const Type* GetAllocatedType() const;
 
-        std::shared_ptr<Type> GetAllocatedType() const;
+        // Whether the slot is only ever loaded from and stored to, so its
+        // address never escapes
+        bool IsPromotable() const;
 
     protected:
-        AllocaInst(Module& module, std::shared_ptr<Type> allocatedType, const std::string& name = "");
+        AllocaInst(Module& module, const Type* allocatedType);
     
     private:
-        TempValue* _name;
-        Codegen::MemoryValue* _memory;
         int _offset;
-        std::shared_ptr<Type> _allocatedType;
+        const Type* _allocatedType;
     };
 }
 
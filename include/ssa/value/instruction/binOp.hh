@@ -1,29 +1,36 @@
 #ifndef VIPER_SSA_INSTRUCTION_BINOP_HH
 #define VIPER_SSA_INSTRUCTION_BINOP_HH
 #include <ssa/value/instruction/instruction.hh>
-#include <ssa/value/tmpValue.hh>
 #include <memory>
 
 namespace SSA
 {
     class BinOp : public Instruction
     {
+    friend class Arena;
     friend class Builder;
     public:
+        Value* GetLHS() const;
+        Value* GetRHS() const;
+        // Lets passes turn x + c into x - c and back
+        void SetInstType(InstType type);
+
+        static bool IsAssociative(InstType type);
+        static bool IsCommutative(InstType type);
+        // The operation is as wide as its widest operand, and literals are
+        // 64 bits wide
+        static const Type* GetResultType(Value* lhs, Value* rhs);
+
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
-
     protected:
-        BinOp(Module& module, InstType type, Value* lhs, Value* rhs, const std::string& name = "");
-        
+        BinOp(Module& module, InstType type, Value* lhs, Value* rhs);
+
     private:
-        TempValue* _name;
-        Value* _lhs;
-        Value* _rhs;
+        Codegen::Value* EmitOperation(Codegen::Assembly& assembly, Codegen::Value* lhs, Codegen::Value* rhs);
+        Codegen::Value* EmitDivision(Codegen::Assembly& assembly, Codegen::Value* lhs, Codegen::Value* rhs);
     };
 }
 
@@ -1,27 +1,25 @@
 #ifndef VIPER_SSA_INSTRUCTION_CALL_HH
 #define VIPER_SSA_INSTRUCTION_CALL_HH
 #include <ssa/value/instruction/instruction.hh>
-#include <ssa/value/tmpValue.hh>
 #include <memory>
 
 namespace SSA
 {
     class CallInst : public Instruction
     {
+    friend class Arena;
     friend class Builder;
     public:
+        Function* GetCallee() const;
+
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
-
     protected:
-        CallInst(Module& module, Function* callee, const std::string& name = "");
+        CallInst(Module& module, Function* callee);
         
     private:
-        TempValue* _name;
         Function* _callee;
     };
 }
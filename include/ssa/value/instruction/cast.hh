@@ -0,0 +1,25 @@
+#ifndef VIPER_SSA_INSTRUCTION_CAST_HH
+#define VIPER_SSA_INSTRUCTION_CAST_HH
+#include <ssa/value/instruction/instruction.hh>
+
+namespace SSA
+{
+    // Converts an integer to another width, sign-extending a narrower
+    // value and wrapping a wider one around
+    class CastInst : public Instruction
+    {
+    friend class Arena;
+    friend class Builder;
+    public:
+        Value* GetValue() const;
+
+        void Print(std::ostream& stream, int indent) const override;
+
+        Codegen::Value* Emit(Codegen::Assembly& assembly) override;
+
+    protected:
+        CastInst(Module& module, Value* value, const Type* type);
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,11 +1,18 @@
 #ifndef VIPER_SSA_INSTRUCTION_HH
 #define VIPER_SSA_INSTRUCTION_HH
 #include <ssa/value/value.hh>
+#include <vector>
 
 namespace SSA
 {
+    class BasicBlock;
+
+    // Instructions with an effect (stores and returns) are linked into their
+    // block's instruction list in program order. Instructions that only
+    // produce a value are reached through the operands of their users
     class Instruction : public Value
     {
+    friend class BasicBlock;
     public:
         enum InstType
         {
@@ -14,6 +21,8 @@ namespace SSA
             Alloca,
             Load,
             Store,
+            Call,
+            Cast,
 
             Add,
             Sub,
@@ -21,13 +30,39 @@ namespace SSA
             Div,
         };
 
-        Instruction(Module& module) : Value(module) {  }
-        virtual ~Instruction() {  }
+        Instruction(Module& module, unsigned int operandCount);
 
         InstType GetInstType() const { return _instType; }
+
+        unsigned int GetOperandCount() const { return _operandCount; }
+        Value* GetOperand(unsigned int index) const { return _operands[index].Get(); }
+        void SetOperand(unsigned int index, Value* value) { _operands[index].Set(value); }
+
+        BasicBlock* GetParent() const { return _parent; }
+        Instruction* GetPrev() const { return _prev; }
+        Instruction* GetNext() const { return _next; }
+
+        // Unlinks the instruction from its block, if it is in one, and
+        // releases its operands. The instruction must have no uses left
+        void EraseFromParent();
+
     protected:
+        void PrintResult(std::ostream& stream, int indent) const { stream << std::string(indent, ' ') << "%" << GetID() << " = "; }
+
         InstType _instType;
+
+    private:
+        Use* _operands;
+        unsigned int _operandCount;
+
+        BasicBlock* _parent;
+        Instruction* _prev;
+        Instruction* _next;
     };
+
+    // Erases the instructions of the worklist that are in no block and have
+    // no uses left, then the operands that this leaves unused
+    void EraseDeadInstructions(std::vector<Instruction*>& worklist);
 }
 
-#endif
\ No newline at end of file
+#endif
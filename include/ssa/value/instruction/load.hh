@@ -2,29 +2,23 @@
 #ifndef VIPER_SSA_INSTRUCTION_LOAD_HH
 #define VIPER_SSA_INSTRUCTION_LOAD_HH
 #include <ssa/value/instruction/instruction.hh>
-#include <ssa/value/tmpValue.hh>
 #include <memory>
 
 namespace SSA
 {
     class LoadInst : public Instruction
     {
+    friend class Arena;
     friend class Builder;
     public:
+        Value* GetPointer() const;
+
         void Print(std::ostream& stream, int indent) const override;
-        std::string GetID() const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
-
     protected:
-        LoadInst(Module& module, Value* ptr, const std::string& name = "");
-        
-    private:
-        TempValue* _name;
-        Codegen::Value* _memory;
-        Value* _ptr;
+        LoadInst(Module& module, Value* ptr);
     };
 }
 
@@ -7,19 +7,18 @@ namespace SSA
 {
     class RetInst : public Instruction
     {
+    friend class Arena;
     friend class Builder;
     public:
+        Value* GetValue() const;
+
         void Print(std::ostream& stream, int indent) const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
-
-        void Dispose() override;
         
     protected:
         RetInst(Module& module, Value* value);
-        
-    private:
-        Value* _value;
+
     };
 }
 
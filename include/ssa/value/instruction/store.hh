@@ -7,20 +7,19 @@ namespace SSA
 {
     class StoreInst : public Instruction
     {
+    friend class Arena;
     friend class Builder;
     public:
+        Value* GetPointer() const;
+        Value* GetValue() const;
+
         void Print(std::ostream& stream, int indent) const override;
 
         Codegen::Value* Emit(Codegen::Assembly& assembly) override;
 
-        void Dispose() override;
-
     protected:
         StoreInst(Module& module, Value* ptr, Value* value);
-        
-    private:
-        Value* _ptr;
-        Value* _value;
+
     };
 }
 
@@ -0,0 +1,35 @@
+#ifndef VIPER_SSA_USE_HH
+#define VIPER_SSA_USE_HH
+
+namespace SSA
+{
+    class Value;
+    class Instruction;
+
+    // One operand slot of an instruction. Every use of a value is linked
+    // into that value's use list, so its users can be found, and rewritten,
+    // without scanning the function
+    class Use
+    {
+    public:
+        Use();
+        Use(const Use&) = delete;
+        Use& operator=(const Use&) = delete;
+
+        Value* Get() const;
+        void Set(Value* value);
+
+        Instruction* GetUser() const;
+        Use* GetNext() const;
+
+    private:
+        friend class Instruction;
+
+        Value* _value;
+        Instruction* _user;
+        Use* _prev;
+        Use* _next;
+    };
+}
+
+#endif
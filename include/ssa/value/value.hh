@@ -1,31 +1,57 @@
 #ifndef VIPER_SSA_VALUE_HH
 #define VIPER_SSA_VALUE_HH
 #include <ssa/module.hh>
+#include <ssa/value/use.hh>
 #include <type/types.hh>
 #include <codegen/assembly.hh>
+#include <cstdint>
 #include <ostream>
 #include <memory>
 
 namespace SSA
 {
+    // Every value gets a dense ID from its module when it is created, so
+    // side tables can be flat vectors indexed by GetID(). Textual names only
+    // exist while the IR is being printed. Values are never destroyed one at
+    // a time, so the hierarchy has no virtual destructor and stays trivially
+    // destructible for the module's arena
     class Value
     {
     public:
-        Value(Module& module) :_module(module) {  }
-        virtual ~Value() {  }
+        Value(Module& module) :_type(nullptr), _id(module.NextValueID()), _firstUse(nullptr), _emitted(nullptr), _pendingUses(0), _module(module) {  }
 
         virtual void Print(std::ostream& stream, int indent) const = 0;
-        virtual std::string GetID() const { return ""; }
-        std::shared_ptr<Type> GetType() const { return _type; }
+        // Prints the value as an operand of another instruction
+        virtual void PrintID(std::ostream& stream) const { stream << "%" << _id; }
+        std::uint32_t GetID() const { return _id; }
+        const Type* GetType() const { return _type; }
+        Module& GetModule() const { return _module; }
 
-        virtual Codegen::Value* Emit(Codegen::Assembly& assembly) = 0;
+        Use* GetFirstUse() const { return _firstUse; }
+        bool HasUses() const { return _firstUse != nullptr; }
+        void ReplaceAllUsesWith(Value* value);
 
-        virtual void Dispose() { delete this; }
+        virtual Codegen::Value* Emit(Codegen::Assembly& assembly) = 0;
+        // Emits the value for one of its users. A value with several users
+        // is computed once and its register is kept until every user has
+        // read it
+        Codegen::Value* EmitUse(Codegen::Assembly& assembly);
+        // Whether an earlier user emitted the value and kept it for this one
+        bool IsEmitted() const { return _emitted != nullptr; }
+        // Keeps what Emit returned for the value's other users, as EmitUse
+        // does after emitting it
+        Codegen::Value* KeepForUsers(Codegen::Value* result);
     protected:
-        void SetType(std::shared_ptr<Type> newType) { _type = newType; }
-        std::shared_ptr<Type> _type;
+        void SetType(const Type* newType) { _type = newType; }
+        const Type* _type;
     private:
-        [[maybe_unused]] Module& _module;
+        friend class Use;
+
+        std::uint32_t _id;
+        Use* _firstUse;
+        Codegen::Value* _emitted;
+        unsigned int _pendingUses;
+        Module& _module;
     };
 }
 
@@ -0,0 +1,49 @@
+#ifndef VIPER_INTERNER_HH
+#define VIPER_INTERNER_HH
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string_view>
+
+// A handle to an interned identifier. Equal names always map to the same atom,
+// so atoms can be compared and hashed as plain integers
+class Atom
+{
+public:
+    constexpr Atom() : _id(0) {}
+    constexpr explicit Atom(std::uint32_t id) : _id(id) {}
+
+    constexpr std::uint32_t GetID() const { return _id; }
+    constexpr bool IsValid() const { return _id != 0; }
+
+    std::string_view GetName() const;
+
+    constexpr bool operator==(Atom other) const { return _id == other._id; }
+    constexpr bool operator!=(Atom other) const { return _id != other._id; }
+
+    friend std::ostream& operator<<(std::ostream& stream, Atom atom);
+private:
+    std::uint32_t _id;
+};
+
+namespace std
+{
+    template<>
+    struct hash<Atom>
+    {
+        std::size_t operator()(Atom atom) const noexcept
+        {
+            return atom.GetID();
+        }
+    };
+}
+
+// Global identifier table, safe to use from several threads at once.
+// Names are spread over independently locked shards by hash
+namespace Interner
+{
+    Atom Intern(std::string_view name);
+    std::string_view GetName(Atom atom);
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef VIPER_SYMBOL_TABLE_HH
+#define VIPER_SYMBOL_TABLE_HH
+#include <symbol/varSymbol.hh>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Maps each name to its innermost declaration. Entries are stored in one
+// array in declaration order and each one remembers the declaration it
+// shadows, so popping a scope just unwinds the array back to the scope's start.
+// Symbols are numbered from 0 in declaration order until the next Reset()
+class SymbolTable
+{
+public:
+    SymbolTable();
+
+    void PushScope();
+    void PopScope();
+
+    // Drops every scope and symbol, keeping the storage for reuse
+    void Reset();
+
+    // The returned symbol is only valid until the next Declare()
+    VarSymbol* Declare(Atom name, const Type* type);
+    VarSymbol* Find(Atom name);
+
+private:
+    static constexpr std::uint32_t NoEntry = UINT32_MAX;
+
+    struct Entry
+    {
+        VarSymbol symbol;
+        std::uint32_t shadowed;
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<std::size_t> _scopes;
+    std::unordered_map<Atom, std::uint32_t> _bindings;
+    std::uint32_t _nextID;
+};
+
+#endif
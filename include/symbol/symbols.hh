@@ -1,7 +0,0 @@
-#ifndef VIPER_SYMBOLS_HH
-#define VIPER_SYMBOLS_HH
-
-#include <symbol/varSymbol.hh>
-VarSymbol* FindSymbol(const std::string& name);
-
-#endif
\ No newline at end of file
@@ -1,19 +1,23 @@
 #ifndef VIPER_VAR_SYMBOL_HH
 #define VIPER_VAR_SYMBOL_HH
+#include <symbol/interner.hh>
 #include <type/types.hh>
+#include <cstdint>
 #include <string>
 
 class VarSymbol
 {
 public:
-    VarSymbol(const std::string& name, std::shared_ptr<Type> type);
+    VarSymbol(Atom name, std::uint32_t id, const Type* type);
 
-    std::string_view GetName() const;
-    std::shared_ptr<Type> GetType() const;
+    Atom GetName() const;
+    std::uint32_t GetID() const;
+    const Type* GetType() const;
 
 private:
-    std::string _name;
-    std::shared_ptr<Type> _type;
+    Atom _name;
+    std::uint32_t _id;
+    const Type* _type;
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,5 @@
 #ifndef VIPER_TYPE_HH
 #define VIPER_TYPE_HH
-#include <memory>
 #include <string>
 
 class Type
@@ -16,7 +15,7 @@ public:
 
     virtual int GetPrimitiveSize() const { return _size; }
 
-    virtual std::shared_ptr<Type> GetBase() { return std::shared_ptr<Type>(this); }
+    virtual const Type* GetBase() const { return this; }
 
     
     virtual bool IsIntegerTy() const { return false; }
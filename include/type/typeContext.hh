@@ -0,0 +1,15 @@
+#ifndef VIPER_TYPE_CONTEXT_HH
+#define VIPER_TYPE_CONTEXT_HH
+#include <type/integerType.hh>
+
+// Owns every type for the lifetime of the process. Each distinct type is
+// created once, so types are passed around as plain pointers and compared
+// by address. Safe to use from several threads at once
+namespace TypeContext
+{
+    constexpr int maxIntegerBits = 64;
+
+    const IntegerType* GetIntegerType(int bits);
+}
+
+#endif
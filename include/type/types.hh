@@ -3,9 +3,6 @@
 
 #include <type/type.hh>
 #include <type/integerType.hh>
-#include <map>
-#include <memory>
+#include <type/typeContext.hh>
 
-extern std::map<std::string, std::shared_ptr<Type>> types;
-
-#endif
\ No newline at end of file
+#endif
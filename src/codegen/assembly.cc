@@ -32,6 +32,11 @@ namespace Codegen
         stream << _output.str() << "\n";
     }
 
+    void Assembly::Append(const Assembly& other)
+    {
+        _output << other._output.str();
+    }
+
 
     void Assembly::CreateGlobal(std::string_view ident)
     {
@@ -55,6 +60,11 @@ namespace Codegen
         _output << "\n\tpush " << GetOpSize(operand->GetSize()) << " " << operand->Emit(64);
     }
 
+    void Assembly::CreatePop(Value* operand)
+    {
+        _output << "\n\tpop " << GetOpSize(operand->GetSize()) << " " << operand->Emit(64);
+    }
+
 
     void Assembly::CreateBinOp(Value* left, Value* right, std::string_view op)
     {
@@ -62,7 +72,20 @@ namespace Codegen
             return;
         VerifyArgs(left, right);
 
-        int smallerSize = left->GetSize() > right->GetSize() ? right->GetSize() : left->GetSize();
+        // Only a mov to a register takes a 64-bit immediate, so a wider
+        // immediate goes through a scratch register
+        if(right->IsImmediate() && !static_cast<ImmediateValue*>(right)->FitsInt32() && (op != "mov" || !left->IsRegister()))
+        {
+            Register* scratch = Register::AllocRegister(*this, RegisterType::Integral);
+            CreateBinOp(scratch, right, "mov");
+            CreateBinOp(left, scratch, op);
+            scratch->Dispose();
+            return;
+        }
+
+        // An immediate is sign-extended to the other operand, so only a
+        // narrower register or memory operand narrows the operation
+        int smallerSize = left->GetSize() > right->GetSize() && !right->IsImmediate() ? right->GetSize() : left->GetSize();
 
         _output << "\n\t" << op << ' ' << GetOpSize(smallerSize) << ' ' << left->Emit(smallerSize) << ", " << right->Emit(smallerSize);
     }
@@ -74,6 +97,22 @@ namespace Codegen
     }
 
 
+    void Assembly::CreateMovsx(Value* left, Value* right, int leftBits, int rightBits)
+    {
+        if(right->IsImmediate() || rightBits >= leftBits)
+        {
+            if(left != right)
+                _output << "\n\tmov " << GetOpSize(leftBits) << ' ' << left->Emit(leftBits) << ", " << right->Emit(leftBits);
+            return;
+        }
+
+        _output << "\n\t" << (rightBits == 32 ? "movsxd " : "movsx ") << left->Emit(leftBits) << ", ";
+        if(right->IsMemory())
+            _output << GetOpSize(rightBits) << ' ';
+        _output << right->Emit(rightBits);
+    }
+
+
     void Assembly::CreateAdd(Value* left, Value* right)
     {
         CreateBinOp(left, right, "add");
@@ -89,9 +128,30 @@ namespace Codegen
         CreateBinOp(left, right, "imul");
     }
 
-    void Assembly::CreateDiv(Value*, Value*)
+    void Assembly::CreateCqo(int bits)
+    {
+        switch(bits)
+        {
+            case 8:
+                _output << "\n\tcbw";
+                break;
+            case 16:
+                _output << "\n\tcwd";
+                break;
+            case 32:
+                _output << "\n\tcdq";
+                break;
+            default:
+                _output << "\n\tcqo";
+                break;
+        }
+    }
+
+    void Assembly::CreateDiv(Value* divisor, int bits)
     {
-        Diagnostics::Error("viper", "Unimplemented feature: Division");
+        if(divisor->IsImmediate())
+            Diagnostics::Error("viper", "Attempt to divide by an immediate");
+        _output << "\n\tidiv " << GetOpSize(bits) << ' ' << divisor->Emit(bits);
     }
 
 
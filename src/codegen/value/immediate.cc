@@ -1,8 +1,10 @@
 #include <codegen/value/immediate.hh>
+#include <cstdint>
+#include <limits>
 
 namespace Codegen
 {
-    ImmediateValue::ImmediateValue(long long value, std::shared_ptr<Type> type)
+    ImmediateValue::ImmediateValue(long long value, const Type* type)
         :_value(value), _type(type)
     {
     }
@@ -26,4 +28,9 @@ namespace Codegen
     {
         return _type->GetPrimitiveSize();
     }
+
+    bool ImmediateValue::FitsInt32() const
+    {
+        return _value >= std::numeric_limits<std::int32_t>::min() && _value <= std::numeric_limits<std::int32_t>::max();
+    }
 }
\ No newline at end of file
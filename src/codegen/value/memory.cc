@@ -2,7 +2,7 @@
 
 namespace Codegen
 {
-    MemoryValue::MemoryValue(int offset, bool isReference, std::shared_ptr<Type> type)
+    MemoryValue::MemoryValue(int offset, bool isReference, const Type* type)
         :_offset(offset), _isReference(isReference), _type(type)
     {
     }
@@ -22,11 +22,6 @@ namespace Codegen
         return true;
     }
 
-    void MemoryValue::Dispose()
-    {
-        return;
-    }
-
     int MemoryValue::GetSize() const
     {
         return _type->GetPrimitiveSize();
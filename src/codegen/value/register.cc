@@ -1,4 +1,6 @@
 #include <codegen/value/register.hh>
+#include <codegen/value/stackSlot.hh>
+#include <codegen/assembly.hh>
 #include <diagnostics.hh>
 #include <array>
 
@@ -6,53 +8,111 @@ namespace Codegen
 {
     using namespace std::literals;
 
+    // Each register with the number of references to the value it holds
     std::array registers = {
-        std::make_pair(false, new Register("al"sv,   "ax"sv,   "eax"sv,  "rax"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("cl"sv,   "cx"sv,   "ecx"sv,  "rcx"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("dl"sv,   "dx"sv,   "edx"sv,  "rdx"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("bl"sv,   "bx"sv,   "ebx"sv,  "rbx"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("spl"sv,  "sp"sv,   "esp"sv,  "rsp"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("bpl"sv,  "bp"sv,   "ebp"sv,  "rbp"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("sil"sv,  "si"sv,   "esi"sv,  "rsi"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("dil"sv,  "di"sv,   "edi"sv,  "rdi"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("r8b"sv,  "r8w"sv,  "r8d"sv,  "r8"sv,    RegisterType::Integral)),
-        std::make_pair(false, new Register("r9b"sv,  "r9w"sv,  "r9d"sv,  "r9"sv,    RegisterType::Integral)),
-        std::make_pair(false, new Register("r10b"sv, "r10w"sv, "r10d"sv, "r10"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("r11b"sv, "r11w"sv, "r11d"sv, "r11"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("r12b"sv, "r12w"sv, "r12d"sv, "r12"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("r13b"sv, "r13w"sv, "r13d"sv, "r13"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("r14b"sv, "r14w"sv, "r14d"sv, "r14"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("r15b"sv, "r15w"sv, "r15d"sv, "r15"sv,   RegisterType::Integral)),
-        std::make_pair(false, new Register("xmm0"sv, "xmm0"sv, "xmm0"sv, "xmm0"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm1"sv, "xmm1"sv, "xmm1"sv, "xmm1"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm2"sv, "xmm2"sv, "xmm2"sv, "xmm2"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm3"sv, "xmm3"sv, "xmm3"sv, "xmm3"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm4"sv, "xmm4"sv, "xmm4"sv, "xmm4"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm5"sv, "xmm5"sv, "xmm5"sv, "xmm5"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm6"sv, "xmm6"sv, "xmm6"sv, "xmm6"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm7"sv, "xmm7"sv, "xmm7"sv, "xmm7"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm8"sv, "xmm8"sv, "xmm8"sv, "xmm8"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm9"sv, "xmm9"sv, "xmm9"sv, "xmm9"sv,  RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm10"sv, "xmm10"sv, "xmm10"sv, "xmm10"sv, RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm11"sv, "xmm11"sv, "xmm11"sv, "xmm11"sv, RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm12"sv, "xmm12"sv, "xmm12"sv, "xmm12"sv, RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm13"sv, "xmm13"sv, "xmm13"sv, "xmm13"sv, RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm14"sv, "xmm14"sv, "xmm14"sv, "xmm14"sv, RegisterType::Floating)),
-        std::make_pair(false, new Register("xmm15"sv, "xmm15"sv, "xmm15"sv, "xmm15"sv, RegisterType::Floating)),
+        std::make_pair(0u, new Register("al"sv,   "ax"sv,   "eax"sv,  "rax"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("cl"sv,   "cx"sv,   "ecx"sv,  "rcx"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("dl"sv,   "dx"sv,   "edx"sv,  "rdx"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("bl"sv,   "bx"sv,   "ebx"sv,  "rbx"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("spl"sv,  "sp"sv,   "esp"sv,  "rsp"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("bpl"sv,  "bp"sv,   "ebp"sv,  "rbp"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("sil"sv,  "si"sv,   "esi"sv,  "rsi"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("dil"sv,  "di"sv,   "edi"sv,  "rdi"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("r8b"sv,  "r8w"sv,  "r8d"sv,  "r8"sv,    RegisterType::Integral)),
+        std::make_pair(0u, new Register("r9b"sv,  "r9w"sv,  "r9d"sv,  "r9"sv,    RegisterType::Integral)),
+        std::make_pair(0u, new Register("r10b"sv, "r10w"sv, "r10d"sv, "r10"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("r11b"sv, "r11w"sv, "r11d"sv, "r11"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("r12b"sv, "r12w"sv, "r12d"sv, "r12"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("r13b"sv, "r13w"sv, "r13d"sv, "r13"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("r14b"sv, "r14w"sv, "r14d"sv, "r14"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("r15b"sv, "r15w"sv, "r15d"sv, "r15"sv,   RegisterType::Integral)),
+        std::make_pair(0u, new Register("xmm0"sv, "xmm0"sv, "xmm0"sv, "xmm0"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm1"sv, "xmm1"sv, "xmm1"sv, "xmm1"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm2"sv, "xmm2"sv, "xmm2"sv, "xmm2"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm3"sv, "xmm3"sv, "xmm3"sv, "xmm3"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm4"sv, "xmm4"sv, "xmm4"sv, "xmm4"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm5"sv, "xmm5"sv, "xmm5"sv, "xmm5"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm6"sv, "xmm6"sv, "xmm6"sv, "xmm6"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm7"sv, "xmm7"sv, "xmm7"sv, "xmm7"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm8"sv, "xmm8"sv, "xmm8"sv, "xmm8"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm9"sv, "xmm9"sv, "xmm9"sv, "xmm9"sv,  RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm10"sv, "xmm10"sv, "xmm10"sv, "xmm10"sv, RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm11"sv, "xmm11"sv, "xmm11"sv, "xmm11"sv, RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm12"sv, "xmm12"sv, "xmm12"sv, "xmm12"sv, RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm13"sv, "xmm13"sv, "xmm13"sv, "xmm13"sv, RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm14"sv, "xmm14"sv, "xmm14"sv, "xmm14"sv, RegisterType::Floating)),
+        std::make_pair(0u, new Register("xmm15"sv, "xmm15"sv, "xmm15"sv, "xmm15"sv, RegisterType::Floating)),
     };
 
+    // The values AllocRegister may spill, oldest first, with the number of
+    // references each holds
+    static std::vector<std::pair<Value**, const unsigned int*>> held;
+
     Register::Register(std::string_view id8, std::string_view id16, std::string_view id32, std::string_view id64, RegisterType type)
         :_type(type), _id8(id8), _id16(id16), _id32(id32), _id64(id64)
     {
     }
 
-    Register* Register::AllocRegister(RegisterType type)
+    // The stack and frame pointers are never handed out
+    static bool IsReserved(const std::pair<unsigned int, Register*>& reg)
+    {
+        return &reg == &registers[static_cast<int>(Registers::RSP)] || &reg == &registers[static_cast<int>(Registers::RBP)];
+    }
+
+    static std::pair<unsigned int, Register*>& FindRegister(Register* reg)
+    {
+        for(std::pair<unsigned int, Register*>& r : registers)
+        {
+            if(r.second == reg)
+                return r;
+        }
+        Diagnostics::Error("viper", "Unknown register");
+    }
+
+    // Moves the register to a stack slot if the held values are all that
+    // refer to it, so that nothing still expects it in the register
+    static bool Spill(Assembly& assembly, std::pair<unsigned int, Register*>& reg)
+    {
+        unsigned int references = 0;
+        for(auto& [value, count] : held)
+        {
+            if(*value == reg.second)
+                references += count ? *count : 1;
+        }
+        if(references != reg.first)
+            return false;
+
+        StackSlot* slot = StackSlot::AllocSlot(references);
+        assembly.CreateMov(slot, reg.second);
+        for(auto& [value, count] : held)
+        {
+            if(*value == reg.second)
+                *value = slot;
+        }
+        reg.first = 0;
+        return true;
+    }
+
+    Register* Register::AllocRegister(Assembly& assembly, RegisterType type)
     {
-        for(std::pair<bool, Register*>& reg : registers)
+        for(std::pair<unsigned int, Register*>& reg : registers)
+        {
+            if(!reg.first && type == reg.second->_type && !IsReserved(reg))
+            {
+                reg.first = 1;
+                return reg.second;
+            }
+        }
+
+        // The value held the longest is likely the last to be needed again
+        for(auto& [value, count] : held)
         {
-            if(!reg.first && type == reg.second->_type)
+            if(!(*value)->IsRegister() || static_cast<Register*>(*value)->_type != type)
+                continue;
+            std::pair<unsigned int, Register*>& reg = FindRegister(static_cast<Register*>(*value));
+            if(Spill(assembly, reg))
             {
-                reg.first = true;
+                reg.first = 1;
                 return reg.second;
             }
         }
@@ -61,26 +121,74 @@ namespace Codegen
 
     void Register::FreeRegister(Register* reg)
     {
-        for(std::pair<bool, Register*>& r : registers)
-        {
-            if(r.second == reg)
-                r.first = false;
-        }
+        std::pair<unsigned int, Register*>& r = FindRegister(reg);
+        if(r.first)
+            --r.first;
+    }
+
+    void Register::FreeAllRegisters()
+    {
+        for(std::pair<unsigned int, Register*>& reg : registers)
+            reg.first = 0;
+        held.clear();
     }
 
     Register* Register::GetRegister(std::string_view id)
     {
-        for(std::pair<bool, Register*>& reg : registers)
+        for(std::pair<unsigned int, Register*>& reg : registers)
         {
             if(reg.second->GetID(64) == id)
             {
-                reg.first = true;
+                ++reg.first;
                 return reg.second;
             }
         }
         Diagnostics::Error("viper", "Unknown register '"s + id.data() + "'");
     }
 
+    void Register::RetainRegister(Register* reg, unsigned int count)
+    {
+        FindRegister(reg).first += count;
+    }
+
+    bool Register::IsShared(Register* reg)
+    {
+        return FindRegister(reg).first > 1;
+    }
+
+    unsigned int Register::GetReferenceCount(Register* reg)
+    {
+        return FindRegister(reg).first;
+    }
+
+    std::vector<Register*> Register::GetLiveRegisters(RegisterType type)
+    {
+        std::vector<Register*> live;
+        for(std::pair<unsigned int, Register*>& reg : registers)
+        {
+            if(reg.first && type == reg.second->_type && !IsReserved(reg))
+                live.push_back(reg.second);
+        }
+        return live;
+    }
+
+    void Register::Hold(Value** value, const unsigned int* references)
+    {
+        held.emplace_back(value, references);
+    }
+
+    void Register::Release(Value** value)
+    {
+        for(auto it = held.rbegin(); it != held.rend(); ++it)
+        {
+            if(it->first == value)
+            {
+                held.erase(std::next(it).base());
+                return;
+            }
+        }
+    }
+
     std::string Register::Emit(int bits)
     {
         return std::string(GetID(bits).data());
@@ -0,0 +1,51 @@
+#include <codegen/value/stackSlot.hh>
+#include <memory>
+#include <vector>
+
+namespace Codegen
+{
+    // The current function's slots, and those free to be reused
+    static std::vector<std::unique_ptr<StackSlot>> slots;
+    static std::vector<StackSlot*> freeSlots;
+    static int localsSize = 0;
+
+    StackSlot::StackSlot(int offset)
+        :MemoryValue(offset, false, TypeContext::GetIntegerType(64)), _references(0)
+    {
+    }
+
+    StackSlot* StackSlot::AllocSlot(unsigned int references)
+    {
+        StackSlot* slot;
+        if(freeSlots.empty())
+        {
+            slot = new StackSlot(localsSize + 8 * (slots.size() + 1));
+            slots.emplace_back(slot);
+        }
+        else
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        slot->_references = references;
+        return slot;
+    }
+
+    void StackSlot::FreeAllSlots(int offset)
+    {
+        slots.clear();
+        freeSlots.clear();
+        localsSize = offset;
+    }
+
+    int StackSlot::GetFrameSize()
+    {
+        return localsSize + 8 * slots.size();
+    }
+
+    void StackSlot::Dispose()
+    {
+        if(_references && !--_references)
+            freeSlots.push_back(this);
+    }
+}
\ No newline at end of file
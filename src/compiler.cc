@@ -1,43 +1,37 @@
 #include <compiler.hh>
 #include <lexing/lexer.hh>
+#include <lexing/tokenStream.hh>
 #include <parsing/parser.hh>
+#include <ssa/pass/optimize.hh>
 #include <codegen/assembly.hh>
 #include <diagnostics.hh>
-#include <environment.hh>
-#include <sstream>
 #include <iostream>
 
 
-Compiler::Compiler(OutputType outputType, const std::string& inputFileName)
-    :_outputType(outputType), _inputFileName(inputFileName)
+Compiler::Compiler(OutputType outputType, const std::string& inputFileName, unsigned int jobs, bool streamTokens)
+    :_outputType(outputType), _jobs(jobs), _streamTokens(streamTokens), _inputFileName(inputFileName)
 {
-    _inputHandle = std::ifstream(inputFileName);
-    if(!_inputHandle.is_open())
+    _inputFile = _sourceManager.Load(inputFileName);
+    if(!_inputFile)
         Diagnostics::FatalError("viper", inputFileName + ": No such file or directory");
-    Diagnostics::setFileName(inputFileName);
-    
-    std::stringstream buf;
-    buf << _inputHandle.rdbuf();
-    _contents = buf.str() + '\n';
-
-    _inputHandle.close();
 }
 
 void Compiler::Compile()
 {
-    std::atexit([](){
-        for(VarSymbol* symbol : varSymbols)
-            delete symbol;
-    });
-    Lexing::Lexer lexer(_contents);
-    Parsing::Parser parser(lexer.Lex(), _contents);
+    Lexing::Lexer lexer(*_inputFile);
+    Lexing::TokenList tokenList = _streamTokens ? Lexing::TokenList(_inputFile->GetText()) : lexer.Lex(_jobs);
+    Lexing::TokenStream tokens = _streamTokens ? Lexing::TokenStream(lexer, tokenList) : Lexing::TokenStream(tokenList);
+    Parsing::Parser parser(tokens, *_inputFile);
     SSA::Module module(_inputFileName);
     SSA::Builder builder(module);
     Codegen::Assembly assembly;
 
-    for(std::unique_ptr<Parsing::ASTNode>& node : parser.Parse())
+    Parsing::AST ast = parser.Parse(_jobs);
+    for(Parsing::NodeRef node : ast.GetTopLevel())
     {
-        SSA::Value* value = node->Emit(builder);
+        SSA::Value* value = ast.Emit(node, builder);
+        if(SSA::Function* function = dynamic_cast<SSA::Function*>(value))
+            SSA::OptimizeFunction(*function);
 
         //value->Print(std::cout, 0);
         //std::cout << std::endl;
@@ -46,5 +40,3 @@ void Compiler::Compile()
     }
     assembly.Emit(std::cout);
 }
-
-std::map<std::string, SSA::AllocaInst*> namedValues;
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <diagnostics.hh>
+#include <source/sourceFile.hh>
+#include <algorithm>
 #include <iostream>
 
 constexpr std::string_view bold = "\x1b[1m";
@@ -8,8 +10,6 @@ constexpr std::string_view defaults = "\x1b[0m";
 
 namespace Diagnostics
 {
-    std::string_view fileName;
-
     void FatalError(std::string_view sender, std::string_view message)
     {
         std::cerr << bold << sender << ": " << red << "fatal error: " << defaults << message << "\n";
@@ -24,24 +24,23 @@ namespace Diagnostics
         std::exit(1);
     }
 
-    void CompilerError(const unsigned int lineNumber, const unsigned int colNumber, 
-    std::string_view message,
-    const char* errorBegin, const char* errorEnd,
-    const char* lineBegin, const char* lineEnd)
+    void CompilerError(const SourceFile& file, std::uint32_t errorBegin, std::uint32_t errorEnd,
+    std::string_view message)
     {
-        std::string start  = std::string(lineBegin + 1, errorBegin);
-        std::string error  = std::string(errorBegin, errorEnd);
-        std::string end    = std::string(errorEnd, lineEnd);
+        unsigned int lineNumber = file.GetLine(errorBegin);
+        unsigned int colNumber  = file.GetColumn(errorBegin);
+        std::string_view line   = file.GetLineText(lineNumber);
+
+        std::size_t errorLength = std::min<std::size_t>(errorEnd - errorBegin, line.length() - (colNumber - 1));
+
+        std::string_view start  = line.substr(0, colNumber - 1);
+        std::string_view error  = file.GetText().substr(errorBegin, errorLength);
+        std::string_view end    = line.substr(colNumber - 1 + errorLength);
         std::string spaces = std::string(start.length(), ' ');
 
-        std::cerr << bold << fileName << ":" << lineNumber << ":" << colNumber << ": " << red << "error: " << defaults << message << "\n";
+        std::cerr << bold << file.GetName() << ":" << lineNumber << ":" << colNumber << ": " << red << "error: " << defaults << message << "\n";
         std::cerr << "    " << lineNumber << " | " << start << bold << red << error << defaults << end << "\n";
-        std::cerr << "      | " << spaces << bold << red << "^" << std::string(error.length() - 1, '~') << defaults << "\n";
+        std::cerr << "      | " << spaces << bold << red << "^" << std::string(error.empty() ? 0 : error.length() - 1, '~') << defaults << "\n";
         std::exit(1);
     }
-
-    void setFileName(std::string_view newFileName)
-    {
-        fileName = newFileName;
-    }
 }
\ No newline at end of file
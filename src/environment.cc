@@ -0,0 +1,13 @@
+#include <environment.hh>
+
+void Environment::Bind(std::uint32_t symbolID, SSA::AllocaInst* alloca)
+{
+    if(symbolID >= _values.size())
+        _values.resize(symbolID + 1);
+    _values[symbolID] = alloca;
+}
+
+SSA::AllocaInst* Environment::Find(std::uint32_t symbolID) const
+{
+    return _values[symbolID];
+}
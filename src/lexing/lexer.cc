@@ -1,145 +1,243 @@
 #include <lexing/lexer.hh>
-#include <type/types.hh>
+#include <lexing/reservedWords.hh>
+#include <lexing/scan.hh>
+#include <source/sourceFile.hh>
 #include <diagnostics.hh>
+#include <algorithm>
+#include <limits>
 #include <optional>
-#include <unordered_map>
+#include <thread>
 
 namespace Lexing
 {
-    std::unordered_map<std::string_view, TokenType> keywords = {
-        { "return", TokenType::Return },
-        { "let", TokenType::Let },
-    };
+    Lexer::Lexer(const SourceFile& file)
+        :_file(file), _text(file.GetText()), _position(0), _end(file.GetText().length()), _deferErrors(false)
+    {
+    }
 
-    Lexer::Lexer(const std::string& text)
-        :_text(text), _position(0), _lineNumber(1), _colNumber(1), _lineBegin(&this->_text[_position])
+    TokenList Lexer::Lex()
     {
+        TokenList tokens(_text);
+        LexRange(tokens, _text.length());
+        tokens.Append(Next());
+
+        return tokens;
     }
 
-    std::vector<Token> Lexer::Lex()
+    // Splits the input at newlines and lexes each chunk on its own thread,
+    // assuming it does not start inside a comment or literal. Chunks are then
+    // stitched in order: a chunk that the previous one ran into is re-lexed
+    // from where that one stopped, and errors are reported in source order
+    TokenList Lexer::Lex(unsigned int threadCount)
     {
-        std::vector<Token> tokens;
+        unsigned int chunkCount = std::min<std::size_t>(threadCount, (_text.length() - _position) / MinChunkSize);
+        if(chunkCount <= 1)
+            return Lex();
+
+        std::vector<Chunk> chunks;
+        unsigned int begin = _position;
+        for(unsigned int i = 1; i <= chunkCount && begin < _text.length(); ++i)
+        {
+            unsigned int end = _text.length();
+            if(i < chunkCount)
+            {
+                unsigned int target = std::max<std::size_t>(begin, _position + (_text.length() - _position) * i / chunkCount);
+                end = Scan::FindNewline(_text.data() + target, _text.data() + _text.length()) - _text.data();
+                end = std::min<std::size_t>(end + 1, _text.length());
+            }
+            chunks.push_back(Chunk{ begin, end, end, TokenList(_text), std::nullopt });
+            begin = end;
+        }
+
+        std::vector<std::thread> workers;
+        for(Chunk& chunk : chunks)
+            workers.emplace_back([this, &chunk]() { LexChunk(chunk, chunk.begin); });
+        for(std::thread& worker : workers)
+            worker.join();
+
+        std::size_t tokenCount = 1;
+        for(const Chunk& chunk : chunks)
+            tokenCount += chunk.tokens.Size();
+
+        TokenList tokens(_text);
+        tokens.Reserve(tokenCount);
+        unsigned int position = _position;
+        for(Chunk& chunk : chunks)
+        {
+            if(chunk.begin != position)
+                LexChunk(chunk, position);
+            if(chunk.failure)
+                Diagnostics::CompilerError(_file, chunk.failure->position, chunk.failure->position + 1, chunk.failure->message);
+
+            tokens.Append(chunk.tokens);
+            position = chunk.stop;
+        }
+        _position = position;
+        tokens.Append(Next());
+
+        return tokens;
+    }
 
-        while(_position < _text.length())
+    Token Lexer::Next()
+    {
+        while(_position < _end)
         {
             std::optional<Token> tok = NextToken();
+            Consume();
             if(tok.has_value())
-                tokens.push_back(tok.value());
+                return tok.value();
+        }
+
+        return Token(TokenType::EndOfFile, _text.substr(_text.length()), _text.length());
+    }
+
+    // Lexes every token that starts before end. The last one may run past it
+    void Lexer::LexRange(TokenList& tokens, unsigned int end)
+    {
+        _end = end;
+        tokens.Reserve(tokens.Size() + (end - std::min(_position, end)) / 4);
+        while(_position < _end)
+        {
+            std::optional<Token> tok = NextToken();
             Consume();
+            if(tok.has_value())
+                tokens.Append(tok.value());
         }
+        _end = _text.length();
+    }
 
-        return tokens;
+    void Lexer::LexChunk(Chunk& chunk, unsigned int begin) const
+    {
+        Lexer lexer(_file);
+        lexer._position = begin;
+        lexer._deferErrors = true;
+
+        chunk.begin = begin;
+        chunk.tokens = TokenList(_text);
+        chunk.failure.reset();
+        try
+        {
+            lexer.LexRange(chunk.tokens, chunk.end);
+        }
+        catch(Failure& failure)
+        {
+            chunk.failure = std::move(failure);
+        }
+        chunk.stop = lexer._position;
     }
 
     char Lexer::Current() const
     {
-        return _text[_position];
+        return _position < _text.length() ? _text[_position] : '\0';
     }
 
     char Lexer::Consume()
     {
-        _colNumber++;
-        return _text[_position++];
+        return Current() ? _text[_position++] : '\0';
     }
 
     char Lexer::Peek(int offset) const
     {
-        return _text[_position + offset];
+        return _position + offset < _text.length() ? _text[_position + offset] : '\0';
+    }
+
+    void Lexer::LexerError(std::string_view message)
+    {
+        if(_deferErrors)
+            throw Failure{ _position, std::string(message) };
+        Diagnostics::CompilerError(_file, _position, _position + 1, message);
     }
 
     std::optional<Token> Lexer::NextToken()
     {
-        if(std::isalpha(Current()) || Current() == '_')
+        const char* end = _text.data() + _text.length();
+
+        if(IsCharClass(Current(), IdentifierStart))
         {
             unsigned int start = _position;
-            std::string value = std::string(1, Current());
-            
-            while(std::isalnum(Peek(1)) || Peek(1) == '_')
-            {
-                Consume();
-                value += Current();
-            }
+            unsigned int length = Scan::SkipIdentifier(_text.data() + start + 1, end) - _text.data() - start;
+            _position += length - 1;
 
-            if(auto it = types.find(value); it != types.end())
-                return Token(TokenType::Type, value, start, _position + 1, _lineNumber, _colNumber);
+            std::string_view value = _text.substr(start, length);
 
-            if(auto it = keywords.find(value); it != keywords.end())
-                return Token(keywords.find(value)->second, value, start, _position + 1, _lineNumber, _colNumber);
+            if(const ReservedWords::Entry* reserved = FindReservedWord(value))
+                return Token(reserved->type, value, start, reserved->value);
             
-            return Token(TokenType::Identifier, value, start, _position + 1, _lineNumber, _colNumber);
+            return Token(TokenType::Identifier, value, start, Interner::Intern(value).GetID());
         }
 
-        if(isdigit(Current()))
+        if(IsCharClass(Current(), Digit))
         {
             unsigned int start = _position;
-            std::string value = std::string(1, Current());
+            unsigned long long value = Current() - '0';
+            unsigned int length = Scan::SkipIdentifier(_text.data() + start + 1, end) - _text.data() - start;
 
-            while(std::isalnum(Peek(1)) || Peek(1) == '_')
+            while(_position < start + length - 1)
             {
                 Consume();
-                value += Current();
+                if(!IsCharClass(Current(), Digit))
+                    LexerError("invalid digit '" + std::string(1, Current()) + "' in integer literal");
+                
+                unsigned int digit = Current() - '0';
+                if(value > (std::numeric_limits<long long>::max() - digit) / 10ull)
+                    LexerError("integer literal is too large");
+                value = value * 10 + digit;
             }
 
-            return Token(TokenType::Integer, value, start, _position + 1, _lineNumber, _colNumber);
+            return Token(TokenType::Integer, _text.substr(start, _position - start + 1), start, value);
         }
 
-        switch(Current())
+        if(IsCharClass(Current(), Whitespace))
         {
-            case '\n':
-            {
-                _colNumber = 0;
-                ++_lineNumber;
-                _lineBegin = &_text[_position + 1];
-                return std::nullopt;
-            }
-            case ' ':
-                return std::nullopt;
-            
+            _position = Scan::SkipWhitespace(_text.data() + _position, _text.data() + _end) - _text.data() - 1;
+            return std::nullopt;
+        }
 
+        switch(Current())
+        {
             case '(':
-                return Token(TokenType::LeftParen, "(", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::LeftParen, _text.substr(_position, 1), _position);
             case ')':
-                return Token(TokenType::RightParen, ")", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::RightParen, _text.substr(_position, 1), _position);
 
             case '{':
-                return Token(TokenType::LeftBracket, "{", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::LeftBracket, _text.substr(_position, 1), _position);
             case '}':
-                return Token(TokenType::RightBracket, "}", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::RightBracket, _text.substr(_position, 1), _position);
 
             case '[':
-                return Token(TokenType::LeftSquareBracket, "[", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::LeftSquareBracket, _text.substr(_position, 1), _position);
             case ']':
-                return Token(TokenType::RightSquareBracket, "]", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::RightSquareBracket, _text.substr(_position, 1), _position);
 
             case '<':
-                return Token(TokenType::LeftAngleBracket, "<", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::LeftAngleBracket, _text.substr(_position, 1), _position);
             case '>':
-                return Token(TokenType::RightAngleBracket, ">", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::RightAngleBracket, _text.substr(_position, 1), _position);
 
 
             case '+':
-                return Token(TokenType::Plus, "+", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Plus, _text.substr(_position, 1), _position);
             case '-':
-                return Token(TokenType::Minus, "-", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Minus, _text.substr(_position, 1), _position);
             case '*':
-                return Token(TokenType::Star, "*", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Star, _text.substr(_position, 1), _position);
             case '/':
             {
                 if(Peek(1) == '/')
                 {
-                    while(Current() != '\n')
-                        Consume();
+                    _position = Scan::FindNewline(_text.data() + _position, end) - _text.data() - 1;
                     return std::nullopt;
                 }
                 else if(Peek(1) == '*')
                 {
-                    _position += 2;
-                    while(Current() != '*' && Peek(1) != '/')
-                        Consume();
-                    Consume();
+                    const char* commentEnd = Scan::FindCommentEnd(_text.data() + _position + 2, end);
+                    if(commentEnd == end)
+                        LexerError("unterminated comment");
+                    _position = commentEnd - _text.data() + 1;
                     return std::nullopt;
                 }
-                return Token(TokenType::Slash, "/", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Slash, _text.substr(_position, 1), _position);
             }
 
             case '=':
@@ -147,70 +245,52 @@ namespace Lexing
                 if(Peek(1) == '=')
                 {
                     Consume();
-                    return Token(TokenType::DoubleEquals, "==", _position - 1, _position + 1, _lineNumber, _colNumber);
+                    return Token(TokenType::DoubleEquals, _text.substr(_position - 1, 2), _position - 1);
                 }
-                return Token(TokenType::Equals, "=", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Equals, _text.substr(_position, 1), _position);
             }
 
 
             case ';':
-                return Token(TokenType::Semicolon, ";", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Semicolon, _text.substr(_position, 1), _position);
             case ',':
-                return Token(TokenType::Comma, ",", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Comma, _text.substr(_position, 1), _position);
 
 
             case '#':
-                return Token(TokenType::Hash, "#", _position, _position + 1, _lineNumber, _colNumber);
+                return Token(TokenType::Hash, _text.substr(_position, 1), _position);
 
             
             case '"':
             {
                 Consume();
-                std::string value;
-                int start = _position;
+                unsigned int start = _position;
                 while(Current() != '"')
                 {
-                    switch(Current())
-                {
-                    case '\\':
+                    if(!Current())
+                        LexerError("missing terminating \" character");
+                    if(Current() == '\\')
                     {
                         Consume();
                         switch(Current())
                         {
                             case 'n':
-                                value += '\n';
-                                break;
                             case '\'':
-                                value += '\'';
-                                break;
                             case '\\':
-                                value += '\\';
-                                break;
                             case '0':
-                                value += '\0';
                                 break;
                             default:
-                            {
-                                char* line_end;
-                                int offset = 0;
-                                while(Peek(offset) != '\n')
-                                    offset++;
-                                line_end = &_text[_position + offset];
-                                Diagnostics::CompilerError(_lineNumber, _colNumber, "unknown escape sequence: '\\" + std::string(1, Current()) + "'", &_text[_position], &_text[_position + 1], _lineBegin, line_end);
-                            }
+                                LexerError("unknown escape sequence: '\\" + std::string(1, Current()) + "'");
                         }
-                        break;
                     }
-                    default:
-                        value += Current();
-                }
                     Consume();
                 }
-                return Token(TokenType::String, value, start, _position, _lineNumber, _colNumber);
+                return Token(TokenType::String, _text.substr(start, _position - start), start);
             }
 
             case '\'':
             {
+                unsigned int start = _position;
                 char ch;
                 Consume();
                 switch(Current())
@@ -233,14 +313,7 @@ namespace Lexing
                                 ch = '\0';
                                 break;
                             default:
-                            {
-                                char* line_end;
-                                int offset = 0;
-                                while(Peek(offset) != '\n')
-                                    offset++;
-                                line_end = &_text[_position + offset];
-                                Diagnostics::CompilerError(_lineNumber, _colNumber, "unknown escape sequence: '\\" + std::string(1, Current()) + "'", &_text[_position], &_text[_position + 1], _lineBegin, line_end);
-                            }
+                                LexerError("unknown escape sequence: '\\" + std::string(1, Current()) + "'");
                         }
                         break;
                     }
@@ -249,24 +322,12 @@ namespace Lexing
                 }
                 Consume();
                 if(Current() != '\'')
-                {
-                    char* line_end;
-                    int offset = 0;
-                    while(Peek(offset) != '\n')
-                        offset++;
-                    line_end = &_text[_position + offset];
-                    Diagnostics::CompilerError(_lineNumber, _colNumber, "Missing terminating ' character", &_text[_position], &_text[_position + 1], _lineBegin, line_end);
-                }
-                return Token(TokenType::Integer, std::to_string((int)ch), _position, _position + 1, _lineNumber, _colNumber);
+                    LexerError("Missing terminating ' character");
+                return Token(TokenType::Integer, _text.substr(start, _position - start + 1), start, ch);
             }
 
             default:
-                char* line_end;
-                int offset = 0;
-                while(Peek(offset) != '\n')
-                    offset++;
-                line_end = &_text[_position + offset];
-                Diagnostics::CompilerError(_lineNumber, _colNumber, "stray '" + std::string(1, Current()) + "' found in program", &_text[_position], &_text[_position + 1], _lineBegin, line_end);
+                LexerError("stray '" + std::string(1, Current()) + "' found in program");
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,226 @@
+#include <lexing/scan.hh>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define VIPER_SCAN_X86
+#include <immintrin.h>
+#endif
+
+namespace Lexing
+{
+    namespace Scan
+    {
+        static const char* SkipClassScalar(const char* begin, const char* end, CharClass charClass)
+        {
+            while(begin < end && IsCharClass(*begin, charClass))
+                ++begin;
+            return begin;
+        }
+
+        static const char* FindNewlineScalar(const char* begin, const char* end)
+        {
+            while(begin < end && *begin != '\n')
+                ++begin;
+            return begin;
+        }
+
+        static const char* FindCommentEndScalar(const char* begin, const char* end)
+        {
+            while(begin + 1 < end && !(begin[0] == '*' && begin[1] == '/'))
+                ++begin;
+            return begin + 1 < end ? begin : end;
+        }
+
+#ifdef VIPER_SCAN_X86
+        static inline unsigned int WhitespaceMask(__m128i chars)
+        {
+            __m128i ws = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'))));
+            return _mm_movemask_epi8(ws);
+        }
+
+        // (c - lo) <= (hi - lo) as an unsigned byte comparison
+        static inline __m128i InRange(__m128i chars, char lo, char hi)
+        {
+            __m128i offset = _mm_sub_epi8(chars, _mm_set1_epi8(lo));
+            return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(hi - lo)), offset);
+        }
+
+        static inline unsigned int IdentifierMask(__m128i chars)
+        {
+            __m128i alpha = InRange(_mm_or_si128(chars, _mm_set1_epi8(0x20)), 'a', 'z');
+            __m128i digit = InRange(chars, '0', '9');
+            __m128i underscore = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+            return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), underscore));
+        }
+
+        static const char* SkipWhitespaceSSE2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 16; begin += 16)
+            {
+                unsigned int mask = ~WhitespaceMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin))) & 0xFFFF;
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return SkipClassScalar(begin, end, Whitespace);
+        }
+
+        static const char* SkipIdentifierSSE2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 16; begin += 16)
+            {
+                unsigned int mask = ~IdentifierMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin))) & 0xFFFF;
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return SkipClassScalar(begin, end, IdentifierPart);
+        }
+
+        static const char* FindNewlineSSE2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 16; begin += 16)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')));
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return FindNewlineScalar(begin, end);
+        }
+
+        static const char* FindCommentEndSSE2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 17; begin += 16)
+            {
+                __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + 1));
+                unsigned int mask = _mm_movemask_epi8(_mm_and_si128(
+                    _mm_cmpeq_epi8(first, _mm_set1_epi8('*')), _mm_cmpeq_epi8(second, _mm_set1_epi8('/'))));
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return FindCommentEndScalar(begin, end);
+        }
+
+#define VIPER_AVX2 __attribute__((target("avx2")))
+
+        VIPER_AVX2 static inline unsigned int WhitespaceMask(__m256i chars)
+        {
+            __m256i ws = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n'))));
+            return _mm256_movemask_epi8(ws);
+        }
+
+        VIPER_AVX2 static inline __m256i InRange(__m256i chars, char lo, char hi)
+        {
+            __m256i offset = _mm256_sub_epi8(chars, _mm256_set1_epi8(lo));
+            return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(hi - lo)), offset);
+        }
+
+        VIPER_AVX2 static inline unsigned int IdentifierMask(__m256i chars)
+        {
+            __m256i alpha = InRange(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), 'a', 'z');
+            __m256i digit = InRange(chars, '0', '9');
+            __m256i underscore = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_'));
+            return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(alpha, digit), underscore));
+        }
+
+        VIPER_AVX2 static const char* SkipWhitespaceAVX2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 32; begin += 32)
+            {
+                unsigned int mask = ~WhitespaceMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)));
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return SkipWhitespaceSSE2(begin, end);
+        }
+
+        VIPER_AVX2 static const char* SkipIdentifierAVX2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 32; begin += 32)
+            {
+                unsigned int mask = ~IdentifierMask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)));
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return SkipIdentifierSSE2(begin, end);
+        }
+
+        VIPER_AVX2 static const char* FindNewlineAVX2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 32; begin += 32)
+            {
+                __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+                unsigned int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')));
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return FindNewlineSSE2(begin, end);
+        }
+
+        VIPER_AVX2 static const char* FindCommentEndAVX2(const char* begin, const char* end)
+        {
+            for(; end - begin >= 33; begin += 32)
+            {
+                __m256i first  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+                __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + 1));
+                unsigned int mask = _mm256_movemask_epi8(_mm256_and_si256(
+                    _mm256_cmpeq_epi8(first, _mm256_set1_epi8('*')), _mm256_cmpeq_epi8(second, _mm256_set1_epi8('/'))));
+                if(mask)
+                    return begin + __builtin_ctz(mask);
+            }
+            return FindCommentEndSSE2(begin, end);
+        }
+
+#undef VIPER_AVX2
+#endif
+
+        struct Scanners
+        {
+            const char* (*skipWhitespace)(const char*, const char*);
+            const char* (*skipIdentifier)(const char*, const char*);
+            const char* (*findNewline)(const char*, const char*);
+            const char* (*findCommentEnd)(const char*, const char*);
+        };
+
+        static Scanners SelectScanners()
+        {
+#ifdef VIPER_SCAN_X86
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2"))
+                return { SkipWhitespaceAVX2, SkipIdentifierAVX2, FindNewlineAVX2, FindCommentEndAVX2 };
+            return { SkipWhitespaceSSE2, SkipIdentifierSSE2, FindNewlineSSE2, FindCommentEndSSE2 };
+#else
+            return {
+                [](const char* begin, const char* end) { return SkipClassScalar(begin, end, Whitespace); },
+                [](const char* begin, const char* end) { return SkipClassScalar(begin, end, IdentifierPart); },
+                FindNewlineScalar, FindCommentEndScalar
+            };
+#endif
+        }
+
+        static const Scanners scanners = SelectScanners();
+
+        const char* SkipWhitespace(const char* begin, const char* end)
+        {
+            return scanners.skipWhitespace(begin, end);
+        }
+
+        const char* SkipIdentifier(const char* begin, const char* end)
+        {
+            return scanners.skipIdentifier(begin, end);
+        }
+
+        const char* FindNewline(const char* begin, const char* end)
+        {
+            return scanners.findNewline(begin, end);
+        }
+
+        const char* FindCommentEnd(const char* begin, const char* end)
+        {
+            return scanners.findCommentEnd(begin, end);
+        }
+    }
+}
@@ -1,11 +1,17 @@
 #include <lexing/token.hh>
+#include <type_traits>
 
 namespace Lexing
 {
-    Token::Token(Lexing::TokenType type, const std::string& text,
-        const unsigned int start, const unsigned int end,
-        const unsigned int lineNumber, const unsigned int colNumber)
-        :_type(type), _text(text), _start(start), _end(end), _lineNumber(lineNumber), _colNumber(colNumber)
+    static_assert(std::is_trivially_copyable_v<Token>);
+
+    Token::Token()
+        :_value(0), _start(0), _type(TokenType::EndOfFile)
+    {
+    }
+
+    Token::Token(Lexing::TokenType type, std::string_view text, const unsigned int start, long long value)
+        :_text(text), _value(value), _start(start), _type(type)
     {
     }
 
@@ -69,6 +75,8 @@ namespace Lexing
                 return "StarEquals";
             case TokenType::SlashEquals:
                 return "SlashEquals";
+            case TokenType::EndOfFile:
+                return "EndOfFile";
         }
     }
 
@@ -77,35 +85,36 @@ namespace Lexing
         return _type;
     }
 
-    std::string Token::GetText() const
+    std::string_view Token::GetText() const
     {
         return _text;
     }
 
-
-    unsigned int Token::GetStart() const
+    long long Token::GetValue() const
     {
-        return _start;
+        return _value;
     }
 
-    unsigned int Token::GetEnd() const
+
+    // Identifiers carry their interned name as the value
+    Atom Token::GetAtom() const
     {
-        return _end;
+        return Atom(static_cast<std::uint32_t>(_value));
     }
 
-    unsigned int Token::GetLine() const
+    unsigned int Token::GetStart() const
     {
-        return _lineNumber;
+        return _start;
     }
 
-    unsigned int Token::GetCol() const
+    unsigned int Token::GetEnd() const
     {
-        return _colNumber;
+        return _start + _text.length();
     }
 
     std::ostream& operator<<(std::ostream& stream, Token token)
     {
-        stream << token.GetLine() << ":" << token.GetCol() << " - " << token.TypeAsString() << "(" << token._text << ")";
+        stream << token.GetStart() << " - " << token.TypeAsString() << "(" << token._text << ")";
         return stream;
     }
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include <lexing/tokenList.hh>
+
+namespace Lexing
+{
+    TokenList::TokenList(std::string_view text)
+        :_text(text)
+    {
+    }
+
+    void TokenList::Append(const Token& token)
+    {
+        _types.push_back(static_cast<std::uint8_t>(token.GetType()));
+        _starts.push_back(token.GetStart());
+        _lengths.push_back(token.GetText().length());
+        _values.push_back(token.GetValue());
+    }
+
+    void TokenList::Append(const TokenList& tokens)
+    {
+        _types.insert(_types.end(), tokens._types.begin(), tokens._types.end());
+        _starts.insert(_starts.end(), tokens._starts.begin(), tokens._starts.end());
+        _lengths.insert(_lengths.end(), tokens._lengths.begin(), tokens._lengths.end());
+        _values.insert(_values.end(), tokens._values.begin(), tokens._values.end());
+    }
+
+    void TokenList::Reserve(std::size_t count)
+    {
+        _types.reserve(count);
+        _starts.reserve(count);
+        _lengths.reserve(count);
+        _values.reserve(count);
+    }
+
+    void TokenList::Clear()
+    {
+        _types.clear();
+        _starts.clear();
+        _lengths.clear();
+        _values.clear();
+    }
+}
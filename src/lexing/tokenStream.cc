@@ -0,0 +1,104 @@
+#include <lexing/tokenStream.hh>
+
+namespace Lexing
+{
+    static const Token terminator(TokenType::Semicolon, "", 0);
+
+    TokenStream::TokenStream(const TokenList& tokens)
+        :TokenStream(tokens, 0, tokens.Size() - 1)
+    {
+    }
+
+    TokenStream::TokenStream(const TokenList& tokens, std::size_t begin, std::size_t end)
+        :_tokens(tokens), _window(nullptr), _lexer(nullptr), _index(begin), _end(end), _terminatorPending(false), _current(Get(begin))
+    {
+    }
+
+    TokenStream::TokenStream(Lexer& lexer, TokenList& window)
+        :_tokens(window), _window(&window), _lexer(&lexer), _index(0), _end(0), _terminatorPending(false)
+    {
+        _window->Clear();
+        Refill();
+        _current = Get(_index);
+    }
+
+    bool TokenStream::IsLexing() const
+    {
+        return _lexer != nullptr;
+    }
+
+    const TokenList& TokenStream::GetTokenList() const
+    {
+        return _tokens;
+    }
+
+    std::size_t TokenStream::GetIndex() const
+    {
+        return _index;
+    }
+
+    Token TokenStream::Peek(unsigned int offset) const
+    {
+        if(offset == 0)
+            return _current;
+        return Get(ListIndex(offset));
+    }
+
+    const Token& TokenStream::Consume()
+    {
+        _previous = _current;
+        if(_terminatorPending)
+            _terminatorPending = false;
+        else if(_current.GetType() != TokenType::EndOfFile)
+            ++_index;
+        if(_lexer && _index + Lookahead >= _end)
+            Refill();
+        _current = Get(_index);
+        return _previous;
+    }
+
+    void TokenStream::InsertTerminator()
+    {
+        _terminatorPending = true;
+        _current = terminator;
+    }
+
+    // Past the end of the range the stream reads as an empty EndOfFile token
+    // positioned where the next token starts
+    Token TokenStream::Get(std::size_t index) const
+    {
+        if(index < _end)
+            return _tokens.Get(index);
+        if(_end == _tokens.Size() - 1)
+            return _tokens.Get(_end);
+        return Token(TokenType::EndOfFile, _tokens.GetText(_end).substr(0, 0), _tokens.GetStart(_end));
+    }
+
+    // Moves the tokens left to read to the front of the window and lexes
+    // more after them, up to an EndOfFile token. The window then ends at
+    // that token, like a whole list does
+    void TokenStream::Refill()
+    {
+        if(_end < _tokens.Size() && _tokens.GetType(_end) == TokenType::EndOfFile)
+            return;
+
+        Token unread[Lookahead];
+        std::size_t count = _end - _index;
+        for(std::size_t i = 0; i < count; ++i)
+            unread[i] = _tokens.Get(_index + i);
+        _window->Clear();
+        for(std::size_t i = 0; i < count; ++i)
+            _window->Append(unread[i]);
+
+        while(_window->Size() < WindowSize)
+        {
+            Token token = _lexer->Next();
+            _window->Append(token);
+            if(token.GetType() == TokenType::EndOfFile)
+                break;
+        }
+
+        _index = 0;
+        _end = _window->GetType(_window->Size() - 1) == TokenType::EndOfFile ? _window->Size() - 1 : _window->Size();
+    }
+}
\ No newline at end of file
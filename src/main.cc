@@ -1,13 +1,46 @@
 #include <compiler.hh>
 #include <diagnostics.hh>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
 
 int main(int argc, char** argv)
 {
-    if(argc < 2)
+    unsigned int jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    bool streamTokens = false;
+    const char* inputFileName = nullptr;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if(arg.substr(0, 2) == "-j")
+        {
+            std::string_view count = arg.substr(2);
+            if(count.empty() && i + 1 < argc)
+                count = argv[++i];
+
+            jobs = 0;
+            for(char c : count)
+            {
+                if(c < '0' || c > '9' || jobs > 1024)
+                    Diagnostics::FatalError("viper", "invalid job count: " + std::string(count));
+                jobs = jobs * 10 + (c - '0');
+            }
+            if(jobs == 0)
+                Diagnostics::FatalError("viper", "invalid job count: " + std::string(count));
+        }
+        else if(arg == "--stream-tokens")
+            streamTokens = true;
+        else
+            inputFileName = argv[i];
+    }
+
+    if(!inputFileName)
         Diagnostics::FatalError("viper", "no input files");
 
-    Compiler compile = Compiler(OutputType::Assembly, argv[1]);
+    Compiler compile = Compiler(OutputType::Assembly, inputFileName, jobs, streamTokens);
     compile.Compile();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,202 @@
+#include <parsing/ast/ast.hh>
+#include <diagnostics.hh>
+
+namespace Parsing
+{
+    template<typename T>
+    NodeRef AST::Append(std::vector<T>& nodes, ASTNodeType type, T node)
+    {
+        if(nodes.size() > NodeRef::MaxIndex)
+            Diagnostics::FatalError("viper", "too many AST nodes");
+        nodes.push_back(std::move(node));
+        return NodeRef(type, nodes.size() - 1);
+    }
+
+    NodeRef AST::CreateIntegerLiteral(long long value)
+    {
+        return Append(_integerLiterals, ASTNodeType::Integer, IntegerLiteral{ value });
+    }
+
+    NodeRef AST::CreateBinaryExpression(NodeRef lhs, BinaryOperator op, NodeRef rhs)
+    {
+        return Append(_binaryExpressions, ASTNodeType::BinaryExpression, BinaryExpression{ lhs, rhs, op });
+    }
+
+    NodeRef AST::CreateVariable(Atom name, std::uint32_t symbolID, const Type* type)
+    {
+        return Append(_variables, ASTNodeType::Variable, Variable{ name, symbolID, type });
+    }
+
+    NodeRef AST::CreateCall(Atom callee)
+    {
+        return Append(_calls, ASTNodeType::Call, CallExpr{ callee });
+    }
+
+    NodeRef AST::CreateReturnStatement(NodeRef value, const Type* returnType)
+    {
+        return Append(_returnStatements, ASTNodeType::ReturnStatement, ReturnStatement{ value, returnType });
+    }
+
+    NodeRef AST::CreateCompoundStatement(const NodeRef* statements, std::uint32_t count)
+    {
+        std::uint32_t first = _statements.size();
+        _statements.insert(_statements.end(), statements, statements + count);
+        return Append(_compoundStatements, ASTNodeType::CompoundStatement, CompoundStatement{ first, count });
+    }
+
+    NodeRef AST::CreateVariableDeclaration(Atom name, std::uint32_t symbolID, const Type* type, NodeRef initVal, bool isFunction)
+    {
+        return Append(_variableDeclarations, isFunction ? ASTNodeType::Function : ASTNodeType::VariableDeclaration,
+            VariableDeclaration{ name, symbolID, type, initVal });
+    }
+
+    template<typename T>
+    std::uint32_t AST::Extend(std::vector<T>& nodes, std::vector<T>& other)
+    {
+        std::uint32_t offset = nodes.size();
+        if(nodes.size() + other.size() > NodeRef::MaxIndex)
+            Diagnostics::FatalError("viper", "too many AST nodes");
+        nodes.insert(nodes.end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        return offset;
+    }
+
+    void AST::Append(AST&& other)
+    {
+        std::array<std::uint32_t, 8> offsets = {};
+        offsets[static_cast<int>(ASTNodeType::Integer)] = Extend(_integerLiterals, other._integerLiterals);
+        offsets[static_cast<int>(ASTNodeType::BinaryExpression)] = Extend(_binaryExpressions, other._binaryExpressions);
+        offsets[static_cast<int>(ASTNodeType::Variable)] = Extend(_variables, other._variables);
+        offsets[static_cast<int>(ASTNodeType::Call)] = Extend(_calls, other._calls);
+        offsets[static_cast<int>(ASTNodeType::ReturnStatement)] = Extend(_returnStatements, other._returnStatements);
+        offsets[static_cast<int>(ASTNodeType::CompoundStatement)] = Extend(_compoundStatements, other._compoundStatements);
+        offsets[static_cast<int>(ASTNodeType::VariableDeclaration)] = Extend(_variableDeclarations, other._variableDeclarations);
+        offsets[static_cast<int>(ASTNodeType::Function)] = offsets[static_cast<int>(ASTNodeType::VariableDeclaration)];
+        std::uint32_t statementOffset = Extend(_statements, other._statements);
+
+        auto relocate = [&offsets](NodeRef& node) {
+            if(!node.IsNull())
+                node = NodeRef(node.GetNodeType(), node.GetIndex() + offsets[static_cast<int>(node.GetNodeType())]);
+        };
+
+        for(std::size_t i = offsets[static_cast<int>(ASTNodeType::BinaryExpression)]; i < _binaryExpressions.size(); ++i)
+        {
+            relocate(_binaryExpressions[i].lhs);
+            relocate(_binaryExpressions[i].rhs);
+        }
+        for(std::size_t i = offsets[static_cast<int>(ASTNodeType::ReturnStatement)]; i < _returnStatements.size(); ++i)
+            relocate(_returnStatements[i].value);
+        for(std::size_t i = offsets[static_cast<int>(ASTNodeType::CompoundStatement)]; i < _compoundStatements.size(); ++i)
+            _compoundStatements[i].first += statementOffset;
+        for(std::size_t i = offsets[static_cast<int>(ASTNodeType::VariableDeclaration)]; i < _variableDeclarations.size(); ++i)
+            relocate(_variableDeclarations[i].initVal);
+        for(std::size_t i = statementOffset; i < _statements.size(); ++i)
+            relocate(_statements[i]);
+
+        for(NodeRef node : other._topLevel)
+        {
+            relocate(node);
+            _topLevel.push_back(node);
+        }
+        other = AST();
+    }
+
+    const IntegerLiteral& AST::GetIntegerLiteral(NodeRef node) const
+    {
+        return _integerLiterals[node.GetIndex()];
+    }
+
+    const BinaryExpression& AST::GetBinaryExpression(NodeRef node) const
+    {
+        return _binaryExpressions[node.GetIndex()];
+    }
+
+    const Variable& AST::GetVariable(NodeRef node) const
+    {
+        return _variables[node.GetIndex()];
+    }
+
+    const CallExpr& AST::GetCall(NodeRef node) const
+    {
+        return _calls[node.GetIndex()];
+    }
+
+    const ReturnStatement& AST::GetReturnStatement(NodeRef node) const
+    {
+        return _returnStatements[node.GetIndex()];
+    }
+
+    const CompoundStatement& AST::GetCompoundStatement(NodeRef node) const
+    {
+        return _compoundStatements[node.GetIndex()];
+    }
+
+    const VariableDeclaration& AST::GetVariableDeclaration(NodeRef node) const
+    {
+        return _variableDeclarations[node.GetIndex()];
+    }
+
+    NodeRef AST::GetStatement(std::uint32_t index) const
+    {
+        return _statements[index];
+    }
+
+    void AST::AddTopLevel(NodeRef node)
+    {
+        _topLevel.push_back(node);
+    }
+
+    const std::vector<NodeRef>& AST::GetTopLevel() const
+    {
+        return _topLevel;
+    }
+
+    void AST::Print(NodeRef node, std::ostream& stream, int indent) const
+    {
+        switch(node.GetNodeType())
+        {
+            case ASTNodeType::Integer:
+                return GetIntegerLiteral(node).Print(*this, stream, indent);
+            case ASTNodeType::BinaryExpression:
+                return GetBinaryExpression(node).Print(*this, stream, indent);
+            case ASTNodeType::Variable:
+                return GetVariable(node).Print(*this, stream, indent);
+            case ASTNodeType::Call:
+                return GetCall(node).Print(*this, stream, indent);
+            case ASTNodeType::ReturnStatement:
+                return GetReturnStatement(node).Print(*this, stream, indent);
+            case ASTNodeType::CompoundStatement:
+                return GetCompoundStatement(node).Print(*this, stream, indent);
+            case ASTNodeType::VariableDeclaration:
+                return GetVariableDeclaration(node).Print(*this, stream, indent, false);
+            case ASTNodeType::Function:
+                return GetVariableDeclaration(node).Print(*this, stream, indent, true);
+        }
+    }
+
+    SSA::Value* AST::Emit(NodeRef node, SSA::Builder& builder) const
+    {
+        if(node.IsNull())
+            return nullptr;
+
+        switch(node.GetNodeType())
+        {
+            case ASTNodeType::Integer:
+                return GetIntegerLiteral(node).Emit(*this, builder);
+            case ASTNodeType::BinaryExpression:
+                return GetBinaryExpression(node).Emit(*this, builder);
+            case ASTNodeType::Variable:
+                return GetVariable(node).Emit(*this, builder);
+            case ASTNodeType::Call:
+                return GetCall(node).Emit(*this, builder);
+            case ASTNodeType::ReturnStatement:
+                return GetReturnStatement(node).Emit(*this, builder);
+            case ASTNodeType::CompoundStatement:
+                return GetCompoundStatement(node).Emit(*this, builder);
+            case ASTNodeType::VariableDeclaration:
+                return GetVariableDeclaration(node).Emit(*this, builder, false);
+            case ASTNodeType::Function:
+                return GetVariableDeclaration(node).Emit(*this, builder, true);
+        }
+        return nullptr;
+    }
+}
@@ -1,38 +1,31 @@
-#include <parsing/ast/expression/binaryExpression.hh>
-#include <parsing/ast/expression/integerLiteral.hh>
-#include <parsing/ast/expression/variable.hh>
+#include <parsing/ast/ast.hh>
 #include <environment.hh>
 #include <diagnostics.hh>
+#include <vector>
 
 namespace Parsing
 {
-    BinaryExpression::BinaryExpression(std::unique_ptr<ASTNode> lhs, Lexing::Token op, std::unique_ptr<ASTNode> rhs)
-        :ASTNode(ASTNodeType::BinaryExpression), _lhs(std::move(lhs)), _rhs(std::move(rhs))
+    BinaryOperator GetBinaryOperator(Lexing::TokenType type)
     {
-        switch(op.GetType())
+        switch(type)
         {
             case Lexing::TokenType::Plus:
-                _operator = BinaryOperator::Addition;
-                break;
+                return BinaryOperator::Addition;
             case Lexing::TokenType::Minus:
-                _operator = BinaryOperator::Subtraction;
-                break;
+                return BinaryOperator::Subtraction;
             case Lexing::TokenType::Star:
-                _operator = BinaryOperator::Multiplication;
-                break;
+                return BinaryOperator::Multiplication;
             case Lexing::TokenType::Slash:
-                _operator = BinaryOperator::Division;
-                break;
+                return BinaryOperator::Division;
             case Lexing::TokenType::Equals:
-                _operator = BinaryOperator::Assignment;
             default:
-                break;
+                return BinaryOperator::Assignment;
         }
     }
 
     std::string BinaryExpression::OperatorToString() const
     {
-        switch(_operator)
+        switch(op)
         {
             case BinaryOperator::Addition:
                 return "Addition";
@@ -48,77 +41,109 @@ namespace Parsing
         return "";
     }
 
-    void BinaryExpression::Print(std::ostream& stream, int indent) const
+    // Chains of binary expressions can be hundreds of thousands of nodes
+    // deep, so they are walked with an explicit stack. Each frame remembers
+    // how many of its operands it has handled
+    void BinaryExpression::Print(const AST& ast, std::ostream& stream, int indent) const
     {
-        stream << std::string(indent, ' ') << "<Binary-Expression>:\n";
-        stream << std::string(indent, ' ') << "Lhs: ";
-        _lhs->Print(stream, indent + 2);
-        stream << std::string(indent, ' ') << "\nOperator: " << OperatorToString() << "\n";
-        stream << std::string(indent, ' ') << "Rhs: ";
-        _rhs->Print(stream, indent + 2);
-    }
-
-    SSA::Value* BinaryExpression::Emit(SSA::Builder& builder)
-    {
-        SSA::Value* right = _rhs->Emit(builder);
-        if(_operator == BinaryOperator::Assignment)
+        struct Frame
+        {
+            const BinaryExpression* expression;
+            int indent;
+            int state;
+        };
+        std::vector<Frame> stack = { { this, indent, 0 } };
+        while(!stack.empty())
         {
-            if(Variable* left = dynamic_cast<Variable*>(_lhs.get()))
+            Frame& frame = stack.back();
+            const BinaryExpression& expression = *frame.expression;
+            int frameIndent = frame.indent;
+            NodeRef operand;
+            switch(frame.state++)
             {
-                SSA::AllocaInst* alloca = namedValues[left->GetName()];
-                builder.CreateStore(alloca, right);
-                return right;
+                case 0:
+                    stream << std::string(frameIndent, ' ') << "<Binary-Expression>:\n";
+                    stream << std::string(frameIndent, ' ') << "Lhs: ";
+                    operand = expression.lhs;
+                    break;
+                case 1:
+                    stream << std::string(frameIndent, ' ') << "\nOperator: " << expression.OperatorToString() << "\n";
+                    stream << std::string(frameIndent, ' ') << "Rhs: ";
+                    operand = expression.rhs;
+                    break;
+                default:
+                    stack.pop_back();
+                    continue;
             }
-        }
 
-        SSA::Value* left = _lhs->Emit(builder);
+            if(!operand.IsNull() && operand.GetNodeType() == ASTNodeType::BinaryExpression)
+                stack.push_back({ &ast.GetBinaryExpression(operand), frameIndent + 2, 0 });
+            else
+                ast.Print(operand, stream, frameIndent + 2);
+        }
+    }
 
-        if(SSA::IntegerLiteral* leftI = dynamic_cast<SSA::IntegerLiteral*>(left))
+    SSA::Value* BinaryExpression::Emit(const AST& ast, SSA::Builder& builder) const
+    {
+        // The right operand is emitted first, so the stores of assignments
+        // on the right come before those on the left
+        struct Frame
+        {
+            const BinaryExpression* expression;
+            SSA::Value* right;
+            int state;
+        };
+        std::vector<Frame> stack = { { this, nullptr, 0 } };
+        SSA::Value* result = nullptr;
+        while(!stack.empty())
         {
-            if(SSA::IntegerLiteral* rightI = dynamic_cast<SSA::IntegerLiteral*>(right))
+            Frame& frame = stack.back();
+            const BinaryExpression& expression = *frame.expression;
+            NodeRef operand;
+            switch(frame.state++)
             {
-                long long total;
-                switch (_operator)
-                {
-                    case BinaryOperator::Addition:
-                        total = leftI->GetValue() + rightI->GetValue();
-                        break;
-                    case BinaryOperator::Subtraction:
-                        total = leftI->GetValue() - rightI->GetValue();
-                        break;
-                    case BinaryOperator::Multiplication:
-                        total = leftI->GetValue() * rightI->GetValue();
-                        break;
-                    case BinaryOperator::Division:
-                        total = leftI->GetValue() / rightI->GetValue();
-                        break;
-                    default:
-                        throw; // Unreachable
-                }
-                delete left;
-                delete right;
-                return builder.CreateConstantInt(total);
+                case 0:
+                    operand = expression.rhs;
+                    break;
+                case 1:
+                    frame.right = result;
+                    if(expression.op == BinaryOperator::Assignment && expression.lhs.GetNodeType() == ASTNodeType::Variable)
+                    {
+                        SSA::AllocaInst* alloca = builder.GetEnvironment().Find(ast.GetVariable(expression.lhs).symbolID);
+                        builder.CreateStore(alloca, result);
+                        stack.pop_back();
+                        continue;
+                    }
+                    operand = expression.lhs;
+                    break;
+                default:
+                    result = expression.EmitOperation(builder, result, frame.right);
+                    stack.pop_back();
+                    continue;
             }
+
+            if(!operand.IsNull() && operand.GetNodeType() == ASTNodeType::BinaryExpression)
+                stack.push_back({ &ast.GetBinaryExpression(operand), nullptr, 0 });
+            else
+                result = ast.Emit(operand, builder);
         }
-        SSA::Value* retval = nullptr;
-        switch(_operator)
+        return result;
+    }
+
+    SSA::Value* BinaryExpression::EmitOperation(SSA::Builder& builder, SSA::Value* left, SSA::Value* right) const
+    {
+        switch(op)
         {
             case BinaryOperator::Addition:
-                retval = builder.CreateAdd(left, right);
-                break;
+                return builder.CreateAdd(left, right);
             case BinaryOperator::Subtraction:
-                retval = builder.CreateSub(left, right);
-                break;
+                return builder.CreateSub(left, right);
             case BinaryOperator::Multiplication:
-                retval = builder.CreateMul(left, right);
-                break;
+                return builder.CreateMul(left, right);
             case BinaryOperator::Division:
-                retval = builder.CreateDiv(left, right);
-                break;
+                return builder.CreateDiv(left, right);
             default:
-                break;
+                return nullptr;
         }
-
-        return retval;
     }
 }
\ No newline at end of file
@@ -1,24 +1,19 @@
-#include <parsing/ast/expression/call.hh>
+#include <parsing/ast/ast.hh>
 #include <environment.hh>
 
 namespace Parsing
 {
-    CallExpr::CallExpr(const std::string& callee)
-        :ASTNode(ASTNodeType::Variable), _callee(callee)
+    void CallExpr::Print(const AST&, std::ostream& stream, int indent) const
     {
+        stream << std::string(indent, ' ') << "<Call>: " << callee;
     }
 
-    void CallExpr::Print(std::ostream& stream, int indent) const
+    SSA::Value* CallExpr::Emit(const AST&, SSA::Builder& builder) const
     {
-        stream << std::string(indent, ' ') << "<Call>: " << _callee;
-    }
-
-    SSA::Value* CallExpr::Emit(SSA::Builder& builder)
-    {
-        SSA::Function* function = builder.GetModule().GetFunction(_callee);
+        SSA::Function* function = builder.GetModule().GetFunction(callee);
         if(function)
             return builder.CreateCall(function);
         
         return nullptr;
     }
-}
\ No newline at end of file
+}
@@ -1,25 +1,14 @@
-#include <parsing/ast/expression/integerLiteral.hh>
+#include <parsing/ast/ast.hh>
 
 namespace Parsing
 {
-    IntegerLiteral::IntegerLiteral(long long value)
-        :ASTNode(ASTNodeType::Integer), _value(value)
+    void IntegerLiteral::Print(const AST&, std::ostream& stream, int indent) const
     {
-        _type = types.at("int64");
+        stream << std::string(indent, ' ') << "<Integer-Literal>: " << value;
     }
 
-    void IntegerLiteral::Print(std::ostream& stream, int indent) const
+    SSA::Value* IntegerLiteral::Emit(const AST&, SSA::Builder& builder) const
     {
-        stream << std::string(indent, ' ') << "<Integer-Literal>: " <<_value;
+        return builder.CreateConstantInt(value);
     }
-
-    long long IntegerLiteral::GetValue() const
-    {
-        return _value;
-    }
-
-    SSA::Value* IntegerLiteral::Emit(SSA::Builder& builder)
-    {
-        return builder.CreateConstantInt(_value);
-    }
-}
\ No newline at end of file
+}
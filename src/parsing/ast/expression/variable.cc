@@ -1,28 +1,16 @@
-#include <memory>
-#include <parsing/ast/expression/variable.hh>
+#include <parsing/ast/ast.hh>
 #include <environment.hh>
 
 namespace Parsing
 {
-    Variable::Variable(std::string name, std::shared_ptr<Type> type)
-        :ASTNode(ASTNodeType::Variable), _name(name)
+    void Variable::Print(const AST&, std::ostream& stream, int indent) const
     {
-        _type = type;
+        stream << std::string(indent, ' ') << "<Variable>: " << name;
     }
 
-    void Variable::Print(std::ostream& stream, int indent) const
+    SSA::Value* Variable::Emit(const AST&, SSA::Builder& builder) const
     {
-        stream << std::string(indent, ' ') << "<Variable>: " << _name;
+        SSA::AllocaInst* ptr = builder.GetEnvironment().Find(symbolID);
+        return builder.CreateLoad(ptr);
     }
-
-    SSA::Value* Variable::Emit(SSA::Builder& builder)
-    {
-        SSA::AllocaInst* ptr = namedValues[_name];
-        return builder.CreateLoad(ptr, "");
-    }
-
-    std::string Variable::GetName() const
-    {
-        return _name;
-    }
-}
\ No newline at end of file
+}
@@ -1,27 +1,22 @@
-#include <parsing/ast/statement/compound.hh>
+#include <parsing/ast/ast.hh>
 
 namespace Parsing
 {
-    CompoundStatement::CompoundStatement(std::vector<std::unique_ptr<ASTNode>>& statements)
-        :ASTNode(ASTNodeType::CompoundStatement), _statements(std::move(statements))
-    {
-    }
-
-    void CompoundStatement::Print(std::ostream& stream, int indent) const
+    void CompoundStatement::Print(const AST& ast, std::ostream& stream, int indent) const
     {
         stream << std::string(indent, ' ') << "<Compound-Statement>:";
-        for(const std::unique_ptr<ASTNode>& statement : _statements)
+        for(std::uint32_t i = 0; i < count; ++i)
         {
             stream << "\n";
-            statement->Print(stream, indent + 2);
+            ast.Print(ast.GetStatement(first + i), stream, indent + 2);
         }
     }
 
-    SSA::Value* CompoundStatement::Emit(SSA::Builder& builder)
+    SSA::Value* CompoundStatement::Emit(const AST& ast, SSA::Builder& builder) const
     {
-        for(std::unique_ptr<ASTNode>& statement : _statements)
-            statement->Emit(builder);
+        for(std::uint32_t i = 0; i < count; ++i)
+            ast.Emit(ast.GetStatement(first + i), builder);
 
         return nullptr;
     }
-}
\ No newline at end of file
+}
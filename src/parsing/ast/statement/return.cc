@@ -1,33 +1,23 @@
-#include <parsing/ast/statement/return.hh>
+#include <parsing/ast/ast.hh>
 
 namespace Parsing
 {
-    ReturnStatement::ReturnStatement(std::unique_ptr<ASTNode> value, std::shared_ptr<Type> returnType)
-        :ASTNode(ASTNodeType::ReturnStatement), _value(std::move(value)), _returnType(returnType)
-    {
-    }
-
-    void ReturnStatement::Print(std::ostream& stream, int indent) const
+    void ReturnStatement::Print(const AST& ast, std::ostream& stream, int indent) const
     {
         stream << std::string(indent, ' ') << "<Return-Statement>";
-        if(_value)
+        if(!value.IsNull())
         {
             stream << ":\n" << std::string(indent, ' ') << "Value:\n";
-            _value->Print(stream, indent + 2);
+            ast.Print(value, stream, indent + 2);
         }
     }
 
-    std::shared_ptr<Type> ReturnStatement::GetReturnType() const
-    {
-        return _returnType;
-    }
-
-    SSA::Value* ReturnStatement::Emit(SSA::Builder& builder)
+    SSA::Value* ReturnStatement::Emit(const AST& ast, SSA::Builder& builder) const
     {
-        SSA::Value* value = nullptr;
-        if(_value)
-            value = _value->Emit(builder);
+        SSA::Value* retVal = nullptr;
+        if(!value.IsNull())
+            retVal = ast.Emit(value, builder);
 
-        return builder.CreateRet(value);
+        return builder.CreateRet(retVal);
     }
-}
\ No newline at end of file
+}
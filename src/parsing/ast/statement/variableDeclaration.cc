@@ -1,52 +1,43 @@
-#include "environment.hh"
-#include "ssa/value/basicBlock.hh"
-#include <parsing/ast/statement/variableDeclaration.hh>
+#include <parsing/ast/ast.hh>
+#include <environment.hh>
+#include <ssa/value/basicBlock.hh>
 
 namespace Parsing
 {
-    VariableDeclaration::VariableDeclaration(const std::string& name, std::shared_ptr<Type> type, std::unique_ptr<ASTNode> initVal, bool isFunction)
-        :ASTNode(ASTNodeType::VariableDeclaration), _name(name), _initVal(std::move(initVal)), _isFunction(isFunction)
+    void VariableDeclaration::Print(const AST& ast, std::ostream& stream, int indent, bool isFunction) const
     {
-        _nodeType = (_isFunction ? ASTNodeType::Function : ASTNodeType::VariableDeclaration);
-        _type = type;
-    }
-
-    void VariableDeclaration::Print(std::ostream& stream, int indent) const
-    {
-        stream << std::string(indent, ' ') << (_isFunction ? "<Function>:\n" : "<Variable-Declaration>:\n");
-        stream << std::string(indent, ' ') << "Name: " << _name;
-        if(_initVal)
+        stream << std::string(indent, ' ') << (isFunction ? "<Function>:\n" : "<Variable-Declaration>:\n");
+        stream << std::string(indent, ' ') << "Name: " << name;
+        if(!initVal.IsNull())
         {
             stream << "\n" << std::string(indent, ' ') << "Value: \n";
-            _initVal->Print(stream, indent + 2);
+            ast.Print(initVal, stream, indent + 2);
         }
     }
 
-    bool VariableDeclaration::IsFunction() const
-    {
-        return _isFunction;
-    }
-
-    SSA::Value* VariableDeclaration::Emit(SSA::Builder& builder)
+    SSA::Value* VariableDeclaration::Emit(const AST& ast, SSA::Builder& builder, bool isFunction) const
     {
-        if(_isFunction)
+        if(isFunction)
         {
-            SSA::Function* func = SSA::Function::Create(builder.GetModule(), _name);
+            SSA::Function* func = SSA::Function::Create(builder.GetModule(), name);
             SSA::BasicBlock* entryBB = SSA::BasicBlock::Create(builder.GetModule(), func);
             builder.SetInsertPoint(entryBB);
-            _initVal->Emit(builder);
+
+            Environment environment;
+            builder.SetEnvironment(&environment);
+            ast.Emit(initVal, builder);
+            builder.SetEnvironment(nullptr);
 
             return func;
         }
-        SSA::AllocaInst* alloca = builder.CreateAlloca(_type);
-        if(_initVal)
+        SSA::AllocaInst* alloca = builder.CreateAlloca(type);
+        if(!initVal.IsNull())
         {
-            SSA::Value* initVal = _initVal->Emit(builder);
-            builder.CreateStore(alloca, initVal);
+            SSA::Value* value = ast.Emit(initVal, builder);
+            builder.CreateStore(alloca, value);
         }
-
-        namedValues[_name] = alloca;
+        builder.GetEnvironment().Bind(symbolID, alloca);
         
         return alloca;
     }
-}
\ No newline at end of file
+}
@@ -1,29 +1,40 @@
 #include <parsing/parser.hh>
-#include <symbol/symbols.hh>
 #include <type/types.hh>
-#include <environment.hh>
 #include <diagnostics.hh>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 namespace Parsing
 {
-    Parser::Parser(const std::vector<Lexing::Token>& tokens, const std::string& text)
-        :_text(text), _tokens(tokens), _position(0), _currentReturnType(nullptr)
+    Parser::Parser(Lexing::TokenStream& tokens, const SourceFile& file)
+        :_file(file), _tokens(tokens), _currentReturnType(nullptr), _deferErrors(false)
     {
     }
 
-    Lexing::Token Parser::Current() const
+    const Lexing::Token& Parser::Current() const
     {
-        return _tokens[_position];
+        return _tokens.Current();
     }
 
-    Lexing::Token Parser::Consume()
+    const Lexing::Token& Parser::Consume()
     {
-        return _tokens[_position++];
+        return _tokens.Consume();
     }
 
     Lexing::Token Parser::Peek(const int offset) const
     {
-        return _tokens[_position + offset];
+        return _tokens.Peek(offset);
+    }
+
+    Lexing::TokenType Parser::CurrentType() const
+    {
+        return _tokens.CurrentType();
+    }
+
+    Lexing::TokenType Parser::PeekType(const int offset) const
+    {
+        return _tokens.PeekType(offset);
     }
 
     int Parser::GetBinOpPrecedence(Lexing::TokenType type)
@@ -48,76 +59,197 @@ namespace Parsing
 
     void Parser::ExpectToken(Lexing::TokenType tokenType)
     {
-        if(Current().GetType() != tokenType)
+        if(CurrentType() != tokenType)
         {
-            Lexing::Token temp(tokenType, "", 0, 0, 0, 0);
+            Lexing::Token temp(tokenType, "", 0);
 
-            ParserError("Expected '" + temp.TypeAsString() + "', found " + Current().GetText());
+            ParserError("Expected '" + temp.TypeAsString() + "', found " + std::string(Current().GetText()));
         }
     }
 
     void Parser::ParserError(std::string message)
     {
-        unsigned int start = Current().GetStart();
-        while(_text[start] != '\n')
-            start--;
-        unsigned int end = Current().GetEnd();
-        while(_text[end] != '\n')
-            end++;
-        Diagnostics::CompilerError(Current().GetLine(), Current().GetCol(),
-        message, &_text[Current().GetStart()], &_text[Current().GetEnd()],
-                &_text[start], &_text[end]);
+        ParserError(message, Current());
     }
 
+    void Parser::ParserError(std::string message, const Lexing::Token& token)
+    {
+        if(_deferErrors)
+            throw Failure();
+        Diagnostics::CompilerError(_file, token.GetStart(), token.GetEnd(), message);
+    }
 
-    std::vector<std::unique_ptr<ASTNode>> Parser::Parse()
+
+    AST Parser::Parse()
     {
-        std::vector<std::unique_ptr<ASTNode>> result;
-        while(_position < _tokens.size())
+        while(CurrentType() != Lexing::TokenType::EndOfFile)
         {
-            int savePos = _position;
-            std::unique_ptr<ASTNode> expr = ParseExpression();
+            _symbols.Reset();
+
+            Lexing::Token start = Current();
+            NodeRef expr = ParseExpression();
             ExpectToken(Lexing::TokenType::Semicolon);
             Consume();
 
-            if(expr->GetNodeType() == ASTNodeType::Function)
-                result.push_back(std::move(expr));
+            if(expr.GetNodeType() == ASTNodeType::Function)
+                _ast.AddTopLevel(expr);
             else
+                ParserError("Expected top-level expression", start);
+        }
+        return std::move(_ast);
+    }
+
+    // Top-level declarations are independent, so they are split into chunks
+    // at brace depth zero and parsed on worker threads with errors deferred.
+    // The chunk ASTs are merged in source order. From the first chunk that
+    // failed, the rest of the file is parsed again sequentially, which
+    // reports exactly the error a sequential parse would. A stream that
+    // lexes on demand has no whole list to split and is parsed sequentially
+    AST Parser::Parse(unsigned int threadCount)
+    {
+        if(_tokens.IsLexing())
+            return Parse();
+
+        const Lexing::TokenList& tokens = _tokens.GetTokenList();
+        std::size_t begin = _tokens.GetIndex();
+        std::size_t end = tokens.Size() - 1;
+
+        std::size_t chunkCount = std::min<std::size_t>(threadCount * 4, (end - begin) / MinChunkTokens);
+        if(threadCount <= 1 || chunkCount <= 1)
+            return Parse();
+
+        std::vector<std::size_t> boundaries = { begin };
+        std::size_t chunkTokens = (end - begin) / chunkCount;
+        int depth = 0;
+        for(std::size_t i = begin; i + 1 < end; ++i)
+        {
+            switch(tokens.GetType(i))
             {
-                _position = savePos;
-                ParserError("Expected top-level expression");
+                case Lexing::TokenType::LeftBracket:
+                    ++depth;
+                    continue;
+                case Lexing::TokenType::RightBracket:
+                    --depth;
+                    break;
+                case Lexing::TokenType::Semicolon:
+                    break;
+                default:
+                    continue;
             }
+            if(depth == 0 && tokens.GetType(i + 1) == Lexing::TokenType::Let && i + 1 - boundaries.back() >= chunkTokens)
+                boundaries.push_back(i + 1);
         }
-        return result;
+        boundaries.push_back(end);
+
+        struct Chunk
+        {
+            AST ast;
+            bool failed = false;
+        };
+        std::vector<Chunk> chunks(boundaries.size() - 1);
+        std::atomic<std::size_t> nextChunk = 0;
+
+        auto worker = [&]() {
+            for(std::size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+            {
+                Lexing::TokenStream stream(tokens, boundaries[i], boundaries[i + 1]);
+                Parser parser(stream, _file);
+                parser._deferErrors = true;
+                try
+                {
+                    chunks[i].ast = parser.Parse();
+                }
+                catch(Failure&)
+                {
+                    chunks[i].failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for(unsigned int i = 0; i < std::min<std::size_t>(threadCount, chunks.size()); ++i)
+            workers.emplace_back(worker);
+        for(std::thread& thread : workers)
+            thread.join();
+
+        for(std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            if(chunks[i].failed)
+            {
+                Lexing::TokenStream stream(tokens, boundaries[i], end);
+                Parser parser(stream, _file);
+                _ast.Append(parser.Parse());
+                break;
+            }
+            _ast.Append(std::move(chunks[i].ast));
+        }
+        return std::move(_ast);
     }
 
-    std::shared_ptr<Type> Parser::ParseType()
+    const Type* Parser::ParseType()
     {
         ExpectToken(Lexing::TokenType::Type);
-        return types.at(Consume().GetText());
+        return TypeContext::GetIntegerType(Consume().GetValue());
     }
     
-    std::unique_ptr<ASTNode> Parser::ParseExpression(int precedence)
+    // Operators and operands are kept on explicit stacks, so neither long
+    // operator chains nor deeply nested parentheses use native stack.
+    // Operators of equal precedence group to the right
+    NodeRef Parser::ParseExpression()
     {
-        std::unique_ptr<ASTNode> lhs = ParsePrimary();
+        // Nested expressions (in blocks, returns, initialisers) share the
+        // parser's stacks above the entries of the expression that contains them
+        std::size_t operandBase = _operands.size();
+        std::size_t operatorBase = _operators.size();
+
+        auto reduce = [this]() {
+            NodeRef rhs = _operands.back();
+            _operands.pop_back();
+            _operands.back() = _ast.CreateBinaryExpression(_operands.back(), _operators.back().op, rhs);
+            _operators.pop_back();
+        };
 
         while(true)
         {
-            int binOpPrecedence = GetBinOpPrecedence(Current().GetType());
-            if(binOpPrecedence < precedence)
-                break;
+            while(CurrentType() == Lexing::TokenType::LeftParen)
+            {
+                Consume();
+                _operators.push_back({ BinaryOperator::Assignment, 0 });
+            }
 
-            Lexing::Token operatorToken = Consume();
-            std::unique_ptr<ASTNode> rhs = ParseExpression(binOpPrecedence);
-            lhs = std::make_unique<BinaryExpression>(std::move(lhs), operatorToken, std::move(rhs));
-        }
+            NodeRef operand = ParsePrimary();
+            _operands.push_back(operand);
 
-        return lhs;
+            while(true)
+            {
+                int precedence = GetBinOpPrecedence(CurrentType());
+                if(precedence > 0)
+                {
+                    while(_operators.size() > operatorBase && _operators.back().precedence > precedence)
+                        reduce();
+                    _operators.push_back({ GetBinaryOperator(Consume().GetType()), precedence });
+                    break;
+                }
+
+                while(_operators.size() > operatorBase && _operators.back().precedence > 0)
+                    reduce();
+                if(_operators.size() == operatorBase)
+                {
+                    NodeRef result = _operands.back();
+                    _operands.resize(operandBase);
+                    return result;
+                }
+
+                ExpectToken(Lexing::TokenType::RightParen);
+                Consume();
+                _operators.pop_back();
+            }
+        }
     }
 
-    std::unique_ptr<ASTNode> Parser::ParsePrimary()
+    NodeRef Parser::ParsePrimary()
     {
-        switch(Current().GetType())
+        switch(CurrentType())
         {
             case Lexing::TokenType::Let:
                 return ParseVariableDeclaration();
@@ -127,18 +259,16 @@ namespace Parsing
                 return ParseReturnStatement();
             case Lexing::TokenType::Integer:
                 return ParseIntegerLiteral();
-            case Lexing::TokenType::LeftParen:
-                return ParseParenthesizedExpression();
             case Lexing::TokenType::LeftBracket:
                 return ParseCompoundExpression();
             default:
-                ParserError("Expected primary expression, found '" + Current().GetText() + "'");
+                ParserError("Expected primary expression, found '" + std::string(Current().GetText()) + "'");
         }
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseIdentifier()
+    NodeRef Parser::ParseIdentifier()
     {
-        switch(Peek(1).GetType())
+        switch(PeekType(1))
         {
             case Lexing::TokenType::LeftParen:
                 return ParseCallExpression();
@@ -147,17 +277,17 @@ namespace Parsing
         }
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseVariableDeclaration()
+    NodeRef Parser::ParseVariableDeclaration()
     {
         Consume();
 
-        std::shared_ptr<Type> type = ParseType();
+        const Type* type = ParseType();
 
         ExpectToken(Lexing::TokenType::Identifier);
-        std::string name = Consume().GetText();
+        Atom name = Consume().GetAtom();
 
         bool isFunction = false;
-        if(Current().GetType() == Lexing::TokenType::LeftParen)
+        if(CurrentType() == Lexing::TokenType::LeftParen)
         {
             Consume();
             isFunction = true;
@@ -167,93 +297,91 @@ namespace Parsing
             _currentReturnType = type;
         }
 
-        if(!isFunction)
-            varSymbols.push_back(new VarSymbol(name, type));
-
-        if(Current().GetType() != Lexing::TokenType::Equals)
-            return std::make_unique<VariableDeclaration>(name, type, nullptr, isFunction);
-
-        Consume();
-        
-        std::unique_ptr<ASTNode> initVal = ParseExpression();
-        if(isFunction)
+        NodeRef initVal;
+        if(CurrentType() == Lexing::TokenType::Equals)
         {
-            if(initVal->GetNodeType() != ASTNodeType::CompoundStatement && initVal->GetNodeType() != ASTNodeType::ReturnStatement)
-                initVal = std::make_unique<ReturnStatement>(std::move(initVal), _currentReturnType);
+            Consume();
+
+            if(isFunction)
+                _symbols.PushScope();
+            initVal = ParseExpression();
+            if(isFunction)
+            {
+                _symbols.PopScope();
+                if(initVal.GetNodeType() != ASTNodeType::CompoundStatement && initVal.GetNodeType() != ASTNodeType::ReturnStatement)
+                    initVal = _ast.CreateReturnStatement(initVal, _currentReturnType);
+            }
         }
-        
-        return std::make_unique<VariableDeclaration>(name, type, std::move(initVal), isFunction);
+
+        // A variable only comes into scope after its initialiser
+        std::uint32_t symbolID = 0;
+        if(!isFunction)
+            symbolID = _symbols.Declare(name, type)->GetID();
+
+        return _ast.CreateVariableDeclaration(name, symbolID, type, initVal, isFunction);
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseVariable()
+    NodeRef Parser::ParseVariable()
     {
-        std::string name = Consume().GetText();
-        VarSymbol* symbol = FindSymbol(name);
+        const Lexing::Token& token = Consume();
+        Atom name = token.GetAtom();
+        VarSymbol* symbol = _symbols.Find(name);
         if(!symbol)
-        {
-            --_position;
-            ParserError("Undeclared identifier: `" + name + "'.");
-        }
-        return std::make_unique<Variable>(name, symbol->GetType());
+            ParserError("Undeclared identifier: `" + std::string(token.GetText()) + "'.", token);
+        return _ast.CreateVariable(name, symbol->GetID(), symbol->GetType());
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseCallExpression()
+    NodeRef Parser::ParseCallExpression()
     {
-        std::string callee = Consume().GetText();
+        Atom callee = Consume().GetAtom();
         ExpectToken(Lexing::TokenType::LeftParen);
         Consume();
         // TODO: Parse args
         ExpectToken(Lexing::TokenType::RightParen);
         Consume();
 
-        return std::make_unique<CallExpr>(callee);
-    }
-
-    std::unique_ptr<ASTNode> Parser::ParseIntegerLiteral()
-    {
-        long long value = std::stoll(Consume().GetText());
-
-        return std::make_unique<IntegerLiteral>(value);
+        return _ast.CreateCall(callee);
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseReturnStatement()
+    NodeRef Parser::ParseIntegerLiteral()
     {
-        Consume();
-
-        if(Current().GetType() == Lexing::TokenType::Semicolon)
-            return std::make_unique<ReturnStatement>(nullptr, _currentReturnType);
+        long long value = Consume().GetValue();
 
-        return std::make_unique<ReturnStatement>(ParseExpression(), _currentReturnType);
+        return _ast.CreateIntegerLiteral(value);
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseParenthesizedExpression()
+    NodeRef Parser::ParseReturnStatement()
     {
         Consume();
 
-        std::unique_ptr<ASTNode> expr = ParseExpression();
-
-        ExpectToken(Lexing::TokenType::RightParen);
-        Consume();
+        if(CurrentType() == Lexing::TokenType::Semicolon)
+            return _ast.CreateReturnStatement(NodeRef(), _currentReturnType);
 
-        return expr;
+        NodeRef value = ParseExpression();
+        return _ast.CreateReturnStatement(value, _currentReturnType);
     }
 
-    std::unique_ptr<ASTNode> Parser::ParseCompoundExpression()
+    NodeRef Parser::ParseCompoundExpression()
     {
         Consume();
 
-        std::vector<std::unique_ptr<ASTNode>> exprs;
+        _symbols.PushScope();
+        std::size_t statementBase = _statements.size();
 
-        while(Current().GetType() != Lexing::TokenType::RightBracket)
+        while(CurrentType() != Lexing::TokenType::RightBracket)
         {
-            exprs.push_back(ParseExpression());
+            NodeRef statement = ParseExpression();
+            _statements.push_back(statement);
             ExpectToken(Lexing::TokenType::Semicolon);
             Consume();
         }
         Consume();
+        _symbols.PopScope();
 
-        _tokens.insert(_tokens.begin() + _position, Lexing::Token(Lexing::TokenType::Semicolon, "", 0, 0, 0, 0));
+        _tokens.InsertTerminator();
 
-        return std::make_unique<CompoundStatement>(exprs);
+        NodeRef compound = _ast.CreateCompoundStatement(_statements.data() + statementBase, _statements.size() - statementBase);
+        _statements.resize(statementBase);
+        return compound;
     }
 }
\ No newline at end of file
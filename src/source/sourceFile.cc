@@ -0,0 +1,41 @@
+#include <source/sourceFile.hh>
+#include <lexing/scan.hh>
+#include <algorithm>
+
+SourceFile::SourceFile(const std::string& name, std::string_view text)
+    :_name(name), _text(text)
+{
+    const char* begin = _text.data();
+    const char* end = begin + _text.length();
+
+    _lineOffsets.push_back(0);
+    for(const char* newline = Lexing::Scan::FindNewline(begin, end); newline != end; newline = Lexing::Scan::FindNewline(newline + 1, end))
+        _lineOffsets.push_back(newline - begin + 1);
+}
+
+std::string_view SourceFile::GetName() const
+{
+    return _name;
+}
+
+std::string_view SourceFile::GetText() const
+{
+    return _text;
+}
+
+unsigned int SourceFile::GetLine(std::uint32_t offset) const
+{
+    return std::upper_bound(_lineOffsets.begin(), _lineOffsets.end(), offset) - _lineOffsets.begin();
+}
+
+unsigned int SourceFile::GetColumn(std::uint32_t offset) const
+{
+    return offset - _lineOffsets[GetLine(offset) - 1] + 1;
+}
+
+std::string_view SourceFile::GetLineText(unsigned int line) const
+{
+    std::uint32_t begin = _lineOffsets[line - 1];
+    std::uint32_t end = line < _lineOffsets.size() ? _lineOffsets[line] - 1 : _text.length();
+    return _text.substr(begin, end - begin);
+}
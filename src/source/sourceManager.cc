@@ -0,0 +1,52 @@
+#include <source/sourceManager.hh>
+#include <diagnostics.hh>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+SourceManager::~SourceManager()
+{
+    for(Mapping& mapping : _mappings)
+        munmap(mapping.address, mapping.size);
+}
+
+const SourceFile* SourceManager::Load(const std::string& fileName)
+{
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if(fd < 0)
+        return nullptr;
+
+    struct stat info;
+    std::string_view text;
+    if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(address != MAP_FAILED)
+        {
+            madvise(address, info.st_size, MADV_SEQUENTIAL);
+            _mappings.push_back({ address, static_cast<std::size_t>(info.st_size) });
+            text = std::string_view(static_cast<const char*>(address), info.st_size);
+        }
+    }
+    close(fd);
+
+    // Pipes, empty files and anything else that can't be mapped are read normally
+    if(text.data() == nullptr)
+    {
+        std::ifstream handle(fileName);
+        std::stringstream buf;
+        buf << handle.rdbuf();
+        _buffers.push_back(std::make_unique<std::string>(buf.str()));
+        text = *_buffers.back();
+    }
+
+    if(text.length() > std::numeric_limits<std::uint32_t>::max())
+        Diagnostics::FatalError("viper", fileName + ": file too large");
+
+    _files.push_back(std::make_unique<SourceFile>(fileName, text));
+    return _files.back().get();
+}
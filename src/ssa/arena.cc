@@ -0,0 +1,41 @@
+#include <ssa/arena.hh>
+#include <algorithm>
+#include <cstdint>
+
+namespace SSA
+{
+    Arena::Arena()
+        :_position(nullptr), _left(0), _objectCount(0)
+    {
+    }
+
+    std::size_t Arena::GetObjectCount() const
+    {
+        return _objectCount;
+    }
+
+    std::size_t Arena::GetBlockCount() const
+    {
+        return _blocks.size();
+    }
+
+    void* Arena::Allocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t padding = -reinterpret_cast<std::uintptr_t>(_position) & (alignment - 1);
+        if(padding + size > _left)
+        {
+            // Oversized objects get a block of their own
+            std::size_t blockSize = std::max(size + alignment, BlockSize);
+            _blocks.emplace_back(new char[blockSize]);
+            _position = _blocks.back().get();
+            _left = blockSize;
+            padding = -reinterpret_cast<std::uintptr_t>(_position) & (alignment - 1);
+        }
+
+        void* result = _position + padding;
+        _position += padding + size;
+        _left -= padding + size;
+        ++_objectCount;
+        return result;
+    }
+}
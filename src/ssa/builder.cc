@@ -1,10 +1,11 @@
 #include "ssa/value/instruction/call.hh"
 #include <ssa/builder.hh>
+#include <ssa/pass/constantFold.hh>
 
 namespace SSA
 {
     Builder::Builder(Module& module)
-        :_module(module), _insertPoint(nullptr)
+        :_module(module), _insertPoint(nullptr), _environment(nullptr)
     {
     }
 
@@ -18,19 +19,32 @@ namespace SSA
         return _insertPoint;
     }
 
+    void Builder::SetEnvironment(Environment* environment)
+    {
+        _environment = environment;
+    }
+
+    Environment& Builder::GetEnvironment() const
+    {
+        return *_environment;
+    }
+
 
     Value* Builder::CreateConstantInt(long long value)
     {
-        IntegerLiteral* literal = new IntegerLiteral(_module, value);
+        return CreateConstantInt(value, TypeContext::GetIntegerType(64));
+    }
 
-        return literal;
+    Value* Builder::CreateConstantInt(long long value, const Type* type)
+    {
+        return _module.GetConstantInt(value, type);
     }
 
     Value* Builder::CreateRet(Value* value)
     {
-        RetInst* ret = new RetInst(_module, value);
+        RetInst* ret = _module.GetArena().Create<RetInst>(_module, value);
 
-        _insertPoint->GetInstList().push_back(ret);
+        _insertPoint->Append(ret);
 
         return ret;
     }
@@ -55,34 +69,49 @@ namespace SSA
         return CreateBinOp(Instruction::Div, lhs, rhs);
     }
 
-    CallInst* Builder::CreateCall(Function* callee, const std::string& name)
+    CallInst* Builder::CreateCall(Function* callee)
     {
-        CallInst* call = new CallInst(_module, callee, name);
+        CallInst* call = _module.GetArena().Create<CallInst>(_module, callee);
 
         return call;
     }
 
-    AllocaInst* Builder::CreateAlloca(std::shared_ptr<Type> allocatedType, const std::string& name)
+    AllocaInst* Builder::CreateAlloca(const Type* allocatedType)
     {
-        AllocaInst* alloca = new AllocaInst(_module, allocatedType, name);
+        AllocaInst* alloca = _module.GetArena().Create<AllocaInst>(_module, allocatedType);
 
         _insertPoint->GetParent()->GetAllocaList().push_back(alloca);
 
         return alloca;
     }
 
+    Value* Builder::CreateCast(Value* value, const Type* type)
+    {
+        if(value->GetType() == type)
+            return value;
+        if(IntegerLiteral* literal = dynamic_cast<IntegerLiteral*>(value))
+            return _module.GetConstantInt(WrapConstant(literal->GetValue(), type), type);
+
+        CastInst* cast = _module.GetArena().Create<CastInst>(_module, value, type);
+
+        return cast;
+    }
+
     StoreInst* Builder::CreateStore(Value* ptr, Value* value)
     {
-        StoreInst* store = new StoreInst(_module, ptr, value);
+        if(AllocaInst* alloca = dynamic_cast<AllocaInst*>(ptr))
+            value = CreateCast(value, alloca->GetAllocatedType());
+
+        StoreInst* store = _module.GetArena().Create<StoreInst>(_module, ptr, value);
 
-        _insertPoint->GetInstList().push_back(store);
+        _insertPoint->Append(store);
 
         return store;
     }
 
-    LoadInst* Builder::CreateLoad(Value* ptr, const std::string& name)
+    LoadInst* Builder::CreateLoad(Value* ptr)
     {
-        LoadInst* load = new LoadInst(_module, ptr, name);
+        LoadInst* load = _module.GetArena().Create<LoadInst>(_module, ptr);
 
         return load;
     }
@@ -94,7 +123,20 @@ namespace SSA
 
     Value* Builder::CreateBinOp(Instruction::InstType op, Value* lhs, Value* rhs)
     {
-        BinOp* binop = new BinOp(_module, op, lhs, rhs);
+        if(lhs && rhs)
+        {
+            const Type* type = BinOp::GetResultType(lhs, rhs);
+            if(Value* simplified = SimplifyBinOp(op, lhs, rhs, type))
+                return simplified;
+            // Merging constants can leave an identity such as x + 0 behind
+            if(CanonicalizeBinOp(op, lhs, rhs, type))
+            {
+                if(Value* simplified = SimplifyBinOp(op, lhs, rhs, type))
+                    return simplified;
+            }
+        }
+
+        BinOp* binop = _module.GetArena().Create<BinOp>(_module, op, lhs, rhs);
 
         return binop;
     }
@@ -1,22 +1,33 @@
 #include <ssa/module.hh>
 #include <ssa/value/global/function.hh>
+#include <ssa/value/constant/integer.hh>
 
 namespace SSA
 {
     Module::Module(const std::string& id)
-        :_id(id), _instNameCount(0)
+        :_id(id), _valueCount(0)
     {
     }
 
     Module::~Module()
     {
-        for(Value* global : _globals)
-            global->Dispose();
+        for(Function* function : _functions)
+            delete function;
     }
 
-    int Module::GetNextInstName()
+    Arena& Module::GetArena()
     {
-        return _instNameCount++;
+        return _arena;
+    }
+
+    std::uint32_t Module::NextValueID()
+    {
+        return _valueCount++;
+    }
+
+    std::uint32_t Module::GetValueCount() const
+    {
+        return _valueCount;
     }
 
     std::vector<Value*>& Module::GetGlobals()
@@ -24,14 +35,31 @@ namespace SSA
         return _globals;
     }
 
-    Function* Module::GetFunction(std::string_view name) const
+    const std::vector<Function*>& Module::GetFunctions() const
+    {
+        return _functions;
+    }
+
+    void Module::AddFunction(Function* function)
+    {
+        _globals.push_back(function);
+        _functions.push_back(function);
+        _functionIndex.try_emplace(function->GetAtom(), function);
+    }
+
+    Function* Module::GetFunction(Atom name) const
+    {
+        auto it = _functionIndex.find(name);
+        if(it == _functionIndex.end())
+            return nullptr;
+        return it->second;
+    }
+
+    IntegerLiteral* Module::GetConstantInt(long long value, const Type* type)
     {
-        for(Value* global : _globals)
-        {
-            if(Function* func = dynamic_cast<Function*>(global))
-                if(func->GetName() == name)
-                    return func;
-        }
-        return nullptr;
+        IntegerLiteral*& constant = _constants[type][value];
+        if(!constant)
+            constant = _arena.Create<IntegerLiteral>(*this, value, type);
+        return constant;
     }
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include <ssa/pass/constantFold.hh>
+#include <ssa/value/constant/integer.hh>
+#include <ssa/value/instruction/binOp.hh>
+#include <ssa/value/instruction/cast.hh>
+
+namespace SSA
+{
+    // Sign-extends the low bits of value
+    static long long Wrap(unsigned long long value, int bits)
+    {
+        if(bits >= 64)
+            return static_cast<long long>(value);
+        int shift = 64 - bits;
+        return static_cast<long long>(value << shift) >> shift;
+    }
+
+    bool FoldBinOp(Instruction::InstType op, long long lhs, long long rhs, const Type* type, long long& result)
+    {
+        int bits = type->GetScalarSize();
+        lhs = Wrap(lhs, bits);
+        rhs = Wrap(rhs, bits);
+        unsigned long long left = lhs;
+        unsigned long long right = rhs;
+        switch(op)
+        {
+            case Instruction::Add:
+                result = Wrap(left + right, bits);
+                return true;
+            case Instruction::Sub:
+                result = Wrap(left - right, bits);
+                return true;
+            case Instruction::Mul:
+                result = Wrap(left * right, bits);
+                return true;
+            case Instruction::Div:
+                if(rhs == 0)
+                    return false;
+                // The most negative value divided by -1 wraps back to itself
+                result = rhs == -1 ? Wrap(0 - left, bits) : lhs / rhs;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    long long WrapConstant(long long value, const Type* type)
+    {
+        return Wrap(value, type->GetScalarSize());
+    }
+
+    static bool IsConstant(Value* value, long long constant)
+    {
+        IntegerLiteral* literal = dynamic_cast<IntegerLiteral*>(value);
+        return literal && literal->GetValue() == constant;
+    }
+
+    Value* SimplifyBinOp(Instruction::InstType op, Value* lhs, Value* rhs, const Type* type)
+    {
+        Module& module = lhs->GetModule();
+        IntegerLiteral* leftConstant = dynamic_cast<IntegerLiteral*>(lhs);
+        IntegerLiteral* rightConstant = dynamic_cast<IntegerLiteral*>(rhs);
+        if(leftConstant && rightConstant)
+        {
+            long long result;
+            if(FoldBinOp(op, leftConstant->GetValue(), rightConstant->GetValue(), type, result))
+                return module.GetConstantInt(result, type);
+            return nullptr;
+        }
+
+        if(leftConstant && BinOp::IsCommutative(op))
+            std::swap(lhs, rhs);
+
+        // An identity only hands back the operand itself when the operand
+        // has the operation's type
+        Value* identity = lhs->GetType() == type ? lhs : nullptr;
+        switch(op)
+        {
+            case Instruction::Add:
+                if(IsConstant(rhs, 0))
+                    return identity;
+                break;
+            case Instruction::Sub:
+                if(IsConstant(rhs, 0))
+                    return identity;
+                if(lhs == rhs)
+                    return module.GetConstantInt(0, type);
+                break;
+            case Instruction::Mul:
+                if(IsConstant(rhs, 1))
+                    return identity;
+                if(IsConstant(rhs, 0))
+                    return module.GetConstantInt(0, type);
+                break;
+            case Instruction::Div:
+                if(IsConstant(rhs, 1))
+                    return identity;
+                break;
+            default:
+                break;
+        }
+        return nullptr;
+    }
+
+    // Makes x + c or x - c, with c the constant added to x, the one of the
+    // two whose constant is positive
+    static void CanonicalizeAddend(Instruction::InstType& op, long long addend, const Type* type, long long& constant)
+    {
+        long long negated;
+        FoldBinOp(Instruction::Sub, 0, addend, type, negated);
+        op = negated > 0 ? Instruction::Sub : Instruction::Add;
+        constant = negated > 0 ? negated : addend;
+    }
+
+    bool CanonicalizeBinOp(Instruction::InstType& op, Value*& lhs, Value*& rhs, const Type* type)
+    {
+        bool changed = false;
+        if(dynamic_cast<IntegerLiteral*>(lhs) && !dynamic_cast<IntegerLiteral*>(rhs) && BinOp::IsCommutative(op))
+        {
+            std::swap(lhs, rhs);
+            changed = true;
+        }
+
+        IntegerLiteral* rightConstant = dynamic_cast<IntegerLiteral*>(rhs);
+        bool additive = op == Instruction::Add || op == Instruction::Sub;
+        if(!rightConstant || (!additive && op != Instruction::Mul))
+            return changed;
+        long long c2 = rightConstant->GetValue();
+
+        // (x op c1) op c2 becomes x op c3 when both operations wrap at the
+        // same width
+        BinOp* inner = dynamic_cast<BinOp*>(lhs);
+        IntegerLiteral* innerConstant = inner && inner->GetType() == type ? dynamic_cast<IntegerLiteral*>(inner->GetRHS()) : nullptr;
+        if(innerConstant && inner->GetLHS())
+        {
+            long long c1 = innerConstant->GetValue();
+            Instruction::InstType innerOp = inner->GetInstType();
+            long long combined;
+            if(additive && (innerOp == Instruction::Add || innerOp == Instruction::Sub))
+            {
+                long long addend;
+                FoldBinOp(innerOp, 0, c1, type, addend);
+                FoldBinOp(op, addend, c2, type, addend);
+                CanonicalizeAddend(op, addend, type, combined);
+            }
+            else if(op == Instruction::Mul && innerOp == Instruction::Mul)
+                FoldBinOp(Instruction::Mul, c1, c2, type, combined);
+            else
+                return changed;
+
+            lhs = inner->GetLHS();
+            rhs = lhs->GetModule().GetConstantInt(combined, type);
+            return true;
+        }
+
+        // x + c and x - c are rewritten to have a positive constant
+        if(!additive)
+            return changed;
+        long long addend;
+        FoldBinOp(op, 0, c2, type, addend);
+        Instruction::InstType canonical;
+        long long constant;
+        CanonicalizeAddend(canonical, addend, type, constant);
+        if(canonical == op)
+            return changed;
+        op = canonical;
+        rhs = lhs->GetModule().GetConstantInt(constant, type);
+        return true;
+    }
+
+    // Returns the value that binop can be replaced with, if any. Rewriting
+    // the operands in place instead sets changed. Every rewrite either
+    // removes an instruction or moves a constant closer to the root of the
+    // expression, so a function can only be simplified finitely often
+    static Value* Simplify(BinOp* binop, bool& changed)
+    {
+        Value* lhs = binop->GetLHS();
+        Value* rhs = binop->GetRHS();
+        if(!lhs || !rhs)
+            return nullptr;
+
+        if(Value* simplified = SimplifyBinOp(binop->GetInstType(), lhs, rhs, binop->GetType()))
+            return simplified;
+        Instruction::InstType op = binop->GetInstType();
+        if(CanonicalizeBinOp(op, lhs, rhs, binop->GetType()))
+        {
+            binop->SetInstType(op);
+            binop->SetOperand(0, lhs);
+            binop->SetOperand(1, rhs);
+            changed = true;
+        }
+        return nullptr;
+    }
+
+    // A cast of a constant is the constant wrapped to the cast's type
+    static Value* Simplify(CastInst* cast)
+    {
+        IntegerLiteral* literal = dynamic_cast<IntegerLiteral*>(cast->GetValue());
+        if(!literal)
+            return nullptr;
+        return cast->GetModule().GetConstantInt(WrapConstant(literal->GetValue(), cast->GetType()), cast->GetType());
+    }
+
+    void FoldConstants(Function& function)
+    {
+        std::uint32_t valueCount = function.GetLocalValueCount();
+
+        // Operands are visited before their users, so most folds happen on
+        // the first visit
+        std::vector<Instruction*> order = function.GetInstructionsInPostOrder();
+        std::vector<Instruction*> worklist(order.rbegin(), order.rend());
+        std::vector<bool> queued(valueCount);
+        for(Instruction* inst : order)
+            queued[function.GetLocalID(inst)] = true;
+
+        std::vector<Instruction*> dead;
+        while(!worklist.empty())
+        {
+            Instruction* inst = worklist.back();
+            worklist.pop_back();
+            queued[function.GetLocalID(inst)] = false;
+
+            BinOp* binop = dynamic_cast<BinOp*>(inst);
+            CastInst* cast = dynamic_cast<CastInst*>(inst);
+            if((!binop && !cast) || !inst->HasUses())
+                continue;
+
+            Value* operands[] = { inst->GetOperand(0), binop ? binop->GetRHS() : nullptr };
+            bool changed = false;
+            Value* replacement = binop ? Simplify(binop, changed) : Simplify(cast);
+            if(!replacement && !changed)
+                continue;
+
+            for(Use* use = inst->GetFirstUse(); use; use = use->GetNext())
+            {
+                Instruction* user = use->GetUser();
+                if(!queued[function.GetLocalID(user)])
+                {
+                    queued[function.GetLocalID(user)] = true;
+                    worklist.push_back(user);
+                }
+            }
+
+            if(replacement)
+            {
+                inst->ReplaceAllUsesWith(replacement);
+                dead.push_back(inst);
+            }
+            else if(!queued[function.GetLocalID(inst)])
+            {
+                queued[function.GetLocalID(inst)] = true;
+                worklist.push_back(inst);
+            }
+            for(Value* operand : operands)
+            {
+                if(Instruction* operandInst = dynamic_cast<Instruction*>(operand))
+                    dead.push_back(operandInst);
+            }
+            EraseDeadInstructions(dead);
+        }
+    }
+}
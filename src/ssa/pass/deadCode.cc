@@ -0,0 +1,254 @@
+#include <ssa/pass/deadCode.hh>
+#include <ssa/value/instruction/load.hh>
+#include <ssa/value/instruction/store.hh>
+#include <algorithm>
+
+namespace SSA
+{
+    static void EraseAfterReturns(Function& function, std::vector<Instruction*>& dead)
+    {
+        for(BasicBlock* bb : function.GetBasicBlockList())
+        {
+            Instruction* inst = bb->GetFirst();
+            while(inst && inst->GetInstType() != Instruction::Ret)
+                inst = inst->GetNext();
+            if(!inst)
+                continue;
+
+            while(Instruction* next = inst->GetNext())
+            {
+                for(unsigned int i = 0; i < next->GetOperandCount(); ++i)
+                {
+                    if(Instruction* operand = dynamic_cast<Instruction*>(next->GetOperand(i)))
+                        dead.push_back(operand);
+                }
+                next->EraseFromParent();
+            }
+        }
+        EraseDeadInstructions(dead);
+    }
+
+    // Whether evaluating value reads memory, indexed by local ID
+    static bool ReadsMemory(Function& function, Value* value, std::vector<char>& readsMemory)
+    {
+        Instruction* root = dynamic_cast<Instruction*>(value);
+        if(!root)
+            return false;
+
+        // Operand trees are as deep as the expressions they came from, so
+        // they are walked with an explicit stack of instructions and the
+        // next operand of each to look at
+        std::vector<std::pair<Instruction*, unsigned int>> stack = { { root, 0 } };
+        bool reads = false;
+        while(!stack.empty())
+        {
+            auto& [inst, next] = stack.back();
+            char& known = readsMemory[function.GetLocalID(inst)];
+            if(next == 0 && !known && inst->GetInstType() == Instruction::Load)
+                known = 2;
+            if(known)
+            {
+                reads = known == 2;
+                stack.pop_back();
+                continue;
+            }
+            if(next > 0 && reads)
+            {
+                known = 2;
+                stack.pop_back();
+                continue;
+            }
+            if(next == inst->GetOperandCount())
+            {
+                known = 1;
+                reads = false;
+                stack.pop_back();
+                continue;
+            }
+
+            Instruction* operand = dynamic_cast<Instruction*>(inst->GetOperand(next++));
+            reads = false;
+            if(operand)
+                stack.push_back({ operand, 0 });
+        }
+        return readsMemory[function.GetLocalID(root)] == 2;
+    }
+
+    // Walks each block in order. A load reads its slot when the statement
+    // it belongs to runs, so a load under a statement can be forwarded the
+    // value of the last store to its slot earlier in the block, as long as
+    // that value reads no memory itself and so means the same later on. A
+    // store no load reads before the next store to the slot, or before the
+    // function returns, is dead
+    static void ForwardStores(Function& function, std::vector<Instruction*>& dead)
+    {
+        std::vector<bool> tracked(function.GetLocalValueCount());
+        for(AllocaInst* alloca : function.GetAllocaList())
+            tracked[function.GetLocalID(alloca)] = alloca->IsPromotable();
+
+        std::vector<char> readsMemory(function.GetLocalValueCount());
+        std::vector<bool> visited(function.GetLocalValueCount());
+        std::vector<StoreInst*> unread(function.GetLocalValueCount());
+        std::vector<Value*> stored(function.GetLocalValueCount());
+        std::vector<std::uint32_t> touched;
+        std::vector<Instruction*> stack;
+        for(BasicBlock* bb : function.GetBasicBlockList())
+        {
+            Instruction* next;
+            for(Instruction* inst = bb->GetFirst(); inst; inst = next)
+            {
+                next = inst->GetNext();
+
+                stack.push_back(inst);
+                while(!stack.empty())
+                {
+                    Instruction* user = stack.back();
+                    stack.pop_back();
+                    for(unsigned int i = 0; i < user->GetOperandCount(); ++i)
+                    {
+                        Instruction* operand = dynamic_cast<Instruction*>(user->GetOperand(i));
+                        if(!operand || visited[function.GetLocalID(operand)])
+                            continue;
+                        visited[function.GetLocalID(operand)] = true;
+
+                        if(operand->GetInstType() == Instruction::Load)
+                        {
+                            std::uint32_t ptr = function.GetLocalID(static_cast<LoadInst*>(operand)->GetPointer());
+                            if(tracked[ptr] && stored[ptr])
+                            {
+                                operand->ReplaceAllUsesWith(stored[ptr]);
+                                dead.push_back(operand);
+                                continue;
+                            }
+                            unread[ptr] = nullptr;
+                        }
+                        stack.push_back(operand);
+                    }
+                }
+
+                if(inst->GetInstType() == Instruction::Store)
+                {
+                    StoreInst* store = static_cast<StoreInst*>(inst);
+                    std::uint32_t ptr = function.GetLocalID(store->GetPointer());
+                    if(!tracked[ptr])
+                        continue;
+                    if(StoreInst* overwritten = unread[ptr])
+                    {
+                        if(Instruction* value = dynamic_cast<Instruction*>(overwritten->GetValue()))
+                            dead.push_back(value);
+                        overwritten->EraseFromParent();
+                    }
+                    unread[ptr] = store;
+                    stored[ptr] = ReadsMemory(function, store->GetValue(), readsMemory) ? nullptr : store->GetValue();
+                    touched.push_back(ptr);
+                }
+                else if(inst->GetInstType() == Instruction::Ret)
+                {
+                    // Locals die with the function
+                    for(std::uint32_t ptr : touched)
+                    {
+                        if(StoreInst* store = unread[ptr])
+                        {
+                            if(Instruction* value = dynamic_cast<Instruction*>(store->GetValue()))
+                                dead.push_back(value);
+                            store->EraseFromParent();
+                            unread[ptr] = nullptr;
+                        }
+                    }
+                }
+            }
+
+            // What is in memory at the end of a block is only known inside it
+            for(std::uint32_t ptr : touched)
+            {
+                unread[ptr] = nullptr;
+                stored[ptr] = nullptr;
+            }
+            touched.clear();
+        }
+        EraseDeadInstructions(dead);
+    }
+
+    // Erases the slots that are never loaded from, with their stores
+    static void EraseUnreadSlots(Function& function, std::vector<Instruction*>& dead)
+    {
+        std::vector<AllocaInst*>& allocas = function.GetAllocaList();
+        allocas.erase(std::remove_if(allocas.begin(), allocas.end(), [&dead](AllocaInst* alloca) {
+            if(!alloca->IsPromotable())
+                return false;
+            for(Use* use = alloca->GetFirstUse(); use; use = use->GetNext())
+            {
+                if(use->GetUser()->GetInstType() == Instruction::Load)
+                    return false;
+            }
+            while(Use* use = alloca->GetFirstUse())
+            {
+                Instruction* store = use->GetUser();
+                if(Instruction* value = dynamic_cast<Instruction*>(static_cast<StoreInst*>(store)->GetValue()))
+                    dead.push_back(value);
+                store->EraseFromParent();
+            }
+            return true;
+        }), allocas.end());
+        EraseDeadInstructions(dead);
+    }
+
+    // Values no statement reaches, like the result of an expression
+    // statement, still use their operands. Everything above a reachable
+    // value that is not reachable itself is dead
+    static void EraseUnreachableUsers(Function& function, std::vector<Instruction*>& dead)
+    {
+        std::vector<Instruction*> reachable = function.GetInstructionsInPostOrder();
+        std::vector<bool> live(function.GetLocalValueCount());
+        for(Instruction* inst : reachable)
+            live[function.GetLocalID(inst)] = true;
+
+        std::vector<Instruction*> stack;
+        std::vector<Instruction*> users;
+        for(AllocaInst* alloca : function.GetAllocaList())
+            reachable.push_back(alloca);
+        for(Instruction* inst : reachable)
+        {
+            for(Use* use = inst->GetFirstUse(); use; use = use->GetNext())
+            {
+                Instruction* user = use->GetUser();
+                if(!live[function.GetLocalID(user)])
+                {
+                    live[function.GetLocalID(user)] = true;
+                    stack.push_back(user);
+                }
+            }
+            while(!stack.empty())
+            {
+                Instruction* user = stack.back();
+                stack.pop_back();
+                users.push_back(user);
+                for(Use* use = user->GetFirstUse(); use; use = use->GetNext())
+                {
+                    if(!live[function.GetLocalID(use->GetUser())])
+                    {
+                        live[function.GetLocalID(use->GetUser())] = true;
+                        stack.push_back(use->GetUser());
+                    }
+                }
+            }
+        }
+
+        // Users are erased after what uses them
+        for(auto user = users.rbegin(); user != users.rend(); ++user)
+        {
+            (*user)->ReplaceAllUsesWith(nullptr);
+            dead.push_back(*user);
+        }
+        EraseDeadInstructions(dead);
+    }
+
+    void EliminateDeadCode(Function& function)
+    {
+        std::vector<Instruction*> dead;
+        EraseAfterReturns(function, dead);
+        EraseUnreachableUsers(function, dead);
+        ForwardStores(function, dead);
+        EraseUnreadSlots(function, dead);
+    }
+}
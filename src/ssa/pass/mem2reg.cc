@@ -0,0 +1,102 @@
+#include <ssa/pass/mem2reg.hh>
+#include <ssa/value/constant/integer.hh>
+#include <ssa/value/instruction/load.hh>
+#include <ssa/value/instruction/store.hh>
+#include <algorithm>
+
+namespace SSA
+{
+    void PromoteAllocas(Function& function)
+    {
+        std::vector<BasicBlock*>& blocks = function.GetBasicBlockList();
+        std::vector<AllocaInst*>& allocas = function.GetAllocaList();
+        if(blocks.size() != 1 || allocas.empty())
+            return;
+
+        // The value each promoted alloca holds at the current point of the
+        // block, indexed by local ID
+        std::vector<bool> promoted(function.GetLocalValueCount());
+        std::vector<Value*> current(function.GetLocalValueCount());
+        bool any = false;
+        for(AllocaInst* alloca : allocas)
+        {
+            if(alloca->IsPromotable())
+            {
+                // Reading a local before anything was stored to it gives
+                // zero of the local's type
+                promoted[function.GetLocalID(alloca)] = true;
+                current[function.GetLocalID(alloca)] = function.GetModule().GetConstantInt(0, alloca->GetAllocatedType());
+                any = true;
+            }
+        }
+        if(!any)
+            return;
+
+        // A load reads the memory when the statement it belongs to runs, so
+        // the statements are walked in order and the loads under each one
+        // are replaced with what its alloca holds at that point
+        std::vector<bool> visited(function.GetLocalValueCount());
+        std::vector<Instruction*> stack;
+        std::vector<Instruction*> dead;
+        Instruction* next;
+        for(Instruction* inst = blocks.front()->GetFirst(); inst; inst = next)
+        {
+            next = inst->GetNext();
+
+            stack.push_back(inst);
+            while(!stack.empty())
+            {
+                Instruction* user = stack.back();
+                stack.pop_back();
+                for(unsigned int i = 0; i < user->GetOperandCount(); ++i)
+                {
+                    Instruction* operand = dynamic_cast<Instruction*>(user->GetOperand(i));
+                    if(!operand || visited[function.GetLocalID(operand)])
+                        continue;
+                    visited[function.GetLocalID(operand)] = true;
+
+                    if(operand->GetInstType() == Instruction::Load)
+                    {
+                        std::uint32_t ptr = function.GetLocalID(static_cast<LoadInst*>(operand)->GetPointer());
+                        if(promoted[ptr])
+                        {
+                            operand->ReplaceAllUsesWith(current[ptr]);
+                            dead.push_back(operand);
+                            continue;
+                        }
+                    }
+                    stack.push_back(operand);
+                }
+            }
+
+            if(inst->GetInstType() == Instruction::Store)
+            {
+                StoreInst* store = static_cast<StoreInst*>(inst);
+                std::uint32_t ptr = function.GetLocalID(store->GetPointer());
+                if(promoted[ptr])
+                {
+                    current[ptr] = store->GetValue();
+                    if(Instruction* value = dynamic_cast<Instruction*>(store->GetValue()))
+                        dead.push_back(value);
+                    store->EraseFromParent();
+                }
+            }
+        }
+
+        // Loads no statement reaches were not replaced above
+        for(AllocaInst* alloca : allocas)
+        {
+            while(promoted[function.GetLocalID(alloca)] && alloca->HasUses())
+            {
+                Instruction* load = alloca->GetFirstUse()->GetUser();
+                load->ReplaceAllUsesWith(function.GetModule().GetConstantInt(0, alloca->GetAllocatedType()));
+                load->EraseFromParent();
+            }
+        }
+        EraseDeadInstructions(dead);
+
+        allocas.erase(std::remove_if(allocas.begin(), allocas.end(), [&function, &promoted](AllocaInst* alloca) {
+            return promoted[function.GetLocalID(alloca)];
+        }), allocas.end());
+    }
+}
@@ -0,0 +1,19 @@
+#include <ssa/pass/optimize.hh>
+#include <ssa/pass/mem2reg.hh>
+#include <ssa/pass/constantFold.hh>
+#include <ssa/pass/reassociate.hh>
+#include <ssa/pass/valueNumbering.hh>
+#include <ssa/pass/deadCode.hh>
+
+namespace SSA
+{
+    void OptimizeFunction(Function& function)
+    {
+        PromoteAllocas(function);
+        FoldConstants(function);
+        Reassociate(function);
+        NumberValues(function);
+        FoldConstants(function);
+        EliminateDeadCode(function);
+    }
+}
\ No newline at end of file
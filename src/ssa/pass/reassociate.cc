@@ -0,0 +1,125 @@
+#include <ssa/pass/reassociate.hh>
+#include <ssa/pass/constantFold.hh>
+#include <ssa/builder.hh>
+#include <algorithm>
+
+namespace SSA
+{
+    // Whether value is an inner node of a tree rooted further up: an
+    // operation of the same kind and width whose only user is the tree
+    static bool IsInnerNode(Value* value, Instruction::InstType op, const Type* type)
+    {
+        BinOp* binop = dynamic_cast<BinOp*>(value);
+        return binop && binop->GetInstType() == op && binop->GetType() == type
+            && binop->HasUses() && !binop->GetFirstUse()->GetNext();
+    }
+
+    static bool IsRoot(BinOp* binop)
+    {
+        Instruction::InstType op = binop->GetInstType();
+        if(!BinOp::IsAssociative(op) || !binop->HasUses())
+            return false;
+        if(!IsInnerNode(binop, op, binop->GetType()))
+            return true;
+        BinOp* user = dynamic_cast<BinOp*>(binop->GetFirstUse()->GetUser());
+        return !user || user->GetInstType() != op || user->GetType() != binop->GetType();
+    }
+
+    static Value* CreateBinOp(Builder& builder, Instruction::InstType op, Value* lhs, Value* rhs)
+    {
+        return op == Instruction::Add ? builder.CreateAdd(lhs, rhs) : builder.CreateMul(lhs, rhs);
+    }
+
+    // Returns the balanced tree that replaces root, or nullptr if the tree
+    // is already as flat as it can be
+    static Value* Rebuild(Builder& builder, BinOp* root)
+    {
+        Instruction::InstType op = root->GetInstType();
+        const Type* type = root->GetType();
+
+        std::vector<Value*> leaves;
+        std::vector<IntegerLiteral*> constants;
+        std::vector<std::pair<Value*, int>> stack = { { root, 0 } };
+        int depth = 0;
+        while(!stack.empty())
+        {
+            auto [value, level] = stack.back();
+            stack.pop_back();
+            if(value == root || IsInnerNode(value, op, type))
+            {
+                BinOp* binop = static_cast<BinOp*>(value);
+                if(!binop->GetLHS() || !binop->GetRHS())
+                    return nullptr;
+                stack.emplace_back(binop->GetRHS(), level + 1);
+                stack.emplace_back(binop->GetLHS(), level + 1);
+                continue;
+            }
+            depth = std::max(depth, level);
+            if(IntegerLiteral* constant = dynamic_cast<IntegerLiteral*>(value))
+            {
+                constants.push_back(constant);
+                continue;
+            }
+            leaves.push_back(value);
+        }
+
+        int balancedDepth = 0;
+        while((std::size_t(1) << balancedDepth) < leaves.size())
+            ++balancedDepth;
+        if(constants.size() < 2 && depth <= balancedDepth + static_cast<int>(constants.size()))
+            return nullptr;
+
+        long long identity = op == Instruction::Add ? 0 : 1;
+        long long constant = identity;
+        for(IntegerLiteral* literal : constants)
+            FoldBinOp(op, constant, literal->GetValue(), type, constant);
+        if(op == Instruction::Mul && constant == 0)
+            return builder.CreateConstantInt(0, type);
+
+        // Values are ranked by when they were created, which keeps the
+        // rebuilt trees in a canonical order
+        std::sort(leaves.begin(), leaves.end(), [](Value* lhs, Value* rhs) {
+            return lhs->GetID() < rhs->GetID();
+        });
+        // A narrower leaf is converted first, so that every rebuilt
+        // operation wraps at the width of the tree
+        for(Value*& leaf : leaves)
+            leaf = builder.CreateCast(leaf, type);
+        while(leaves.size() > 1)
+        {
+            std::size_t paired = 0;
+            for(std::size_t i = 0; i < leaves.size(); i += 2)
+                leaves[paired++] = i + 1 < leaves.size() ? CreateBinOp(builder, op, leaves[i], leaves[i + 1]) : leaves[i];
+            leaves.resize(paired);
+        }
+
+        Value* result = leaves.empty() ? nullptr : leaves.front();
+        if(constant != identity || !result)
+        {
+            Value* literal = builder.CreateConstantInt(constant, type);
+            result = result ? CreateBinOp(builder, op, result, literal) : literal;
+        }
+        return result;
+    }
+
+    void Reassociate(Function& function)
+    {
+        Builder builder(function.GetModule());
+        std::vector<Instruction*> dead;
+        // Inner trees come first in post-order, so a tree is rebuilt after
+        // the trees among its leaves
+        for(Instruction* inst : function.GetInstructionsInPostOrder())
+        {
+            BinOp* binop = dynamic_cast<BinOp*>(inst);
+            if(!binop || !IsRoot(binop))
+                continue;
+
+            if(Value* replacement = Rebuild(builder, binop))
+            {
+                binop->ReplaceAllUsesWith(replacement);
+                dead.push_back(binop);
+                EraseDeadInstructions(dead);
+            }
+        }
+    }
+}
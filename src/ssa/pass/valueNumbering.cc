@@ -0,0 +1,148 @@
+#include <ssa/pass/valueNumbering.hh>
+#include <ssa/value/constant/integer.hh>
+#include <ssa/value/instruction/binOp.hh>
+#include <ssa/value/instruction/load.hh>
+#include <ssa/value/instruction/store.hh>
+#include <unordered_map>
+
+namespace SSA
+{
+    namespace
+    {
+        // Constants are numbered by their value, everything else by the
+        // ID of the value that represents it
+        struct Operand
+        {
+            bool constant;
+            long long number;
+
+            bool operator==(const Operand& other) const { return constant == other.constant && number == other.number; }
+            bool operator<(const Operand& other) const { return constant != other.constant ? constant < other.constant : number < other.number; }
+        };
+
+        struct Expression
+        {
+            Instruction::InstType op;
+            int bits;
+            Operand lhs;
+            Operand rhs;
+
+            bool operator==(const Expression& other) const { return op == other.op && bits == other.bits && lhs == other.lhs && rhs == other.rhs; }
+        };
+
+        struct ExpressionHash
+        {
+            std::size_t operator()(const Expression& expression) const
+            {
+                std::size_t hash = expression.op * 31 + expression.bits;
+                for(const Operand& operand : { expression.lhs, expression.rhs })
+                    hash = (hash ^ std::hash<long long>()(operand.number) ^ operand.constant) * 0x9E3779B97F4A7C15ull;
+                return hash;
+            }
+        };
+
+        // Expressions leave the table when the scope they were added in is
+        // popped
+        class ValueTable
+        {
+        public:
+            void PushScope() { _scopes.push_back(_log.size()); }
+
+            void PopScope()
+            {
+                for(std::size_t i = _scopes.back(); i < _log.size(); ++i)
+                    _values.erase(_log[i]);
+                _log.resize(_scopes.back());
+                _scopes.pop_back();
+            }
+
+            // Returns the value already computing expression, or records
+            // value as the one that does
+            Value* FindOrInsert(const Expression& expression, Value* value)
+            {
+                auto [it, inserted] = _values.try_emplace(expression, value);
+                if(inserted)
+                    _log.push_back(expression);
+                return it->second;
+            }
+
+        private:
+            std::unordered_map<Expression, Value*, ExpressionHash> _values;
+            std::vector<Expression> _log;
+            std::vector<std::size_t> _scopes;
+        };
+    }
+
+    static Operand GetOperand(Value* value)
+    {
+        if(IntegerLiteral* literal = dynamic_cast<IntegerLiteral*>(value))
+            return { true, literal->GetValue() };
+        return { false, value->GetID() };
+    }
+
+    void NumberValues(Function& function)
+    {
+        ValueTable table;
+        // Stores to a slot bump its version, so only loads that see the
+        // same store are numbered alike
+        std::vector<std::uint32_t> version(function.GetLocalValueCount());
+        std::vector<bool> visited(function.GetLocalValueCount());
+        std::vector<std::pair<Instruction*, unsigned int>> stack;
+        std::vector<Instruction*> dead;
+        for(BasicBlock* bb : function.GetBasicBlockList())
+        {
+            table.PushScope();
+            for(Instruction* inst = bb->GetFirst(); inst; inst = inst->GetNext())
+            {
+                // Operands are numbered before their users, so equal
+                // operands are already the same value
+                stack.emplace_back(inst, 0);
+                while(!stack.empty())
+                {
+                    auto& [user, index] = stack.back();
+                    if(index < user->GetOperandCount())
+                    {
+                        Instruction* operand = dynamic_cast<Instruction*>(user->GetOperand(index++));
+                        if(operand && !visited[function.GetLocalID(operand)])
+                        {
+                            visited[function.GetLocalID(operand)] = true;
+                            stack.emplace_back(operand, 0);
+                        }
+                        continue;
+                    }
+                    Instruction* current = user;
+                    stack.pop_back();
+
+                    Expression expression;
+                    if(BinOp* binop = dynamic_cast<BinOp*>(current))
+                    {
+                        if(!binop->GetLHS() || !binop->GetRHS())
+                            continue;
+                        expression = { binop->GetInstType(), binop->GetType()->GetScalarSize(), GetOperand(binop->GetLHS()), GetOperand(binop->GetRHS()) };
+                        if(BinOp::IsCommutative(expression.op) && expression.rhs < expression.lhs)
+                            std::swap(expression.lhs, expression.rhs);
+                    }
+                    else if(LoadInst* load = dynamic_cast<LoadInst*>(current))
+                    {
+                        expression = { Instruction::Load, 0, { false, load->GetPointer()->GetID() }, { false, version[function.GetLocalID(load->GetPointer())] } };
+                    }
+                    else
+                    {
+                        if(StoreInst* store = dynamic_cast<StoreInst*>(current))
+                            ++version[function.GetLocalID(store->GetPointer())];
+                        continue;
+                    }
+
+                    Value* value = table.FindOrInsert(expression, current);
+                    if(value != current)
+                    {
+                        current->ReplaceAllUsesWith(value);
+                        dead.push_back(current);
+                    }
+                }
+            }
+            table.PopScope();
+        }
+        EraseDeadInstructions(dead);
+    }
+}
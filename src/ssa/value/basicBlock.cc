@@ -1,24 +1,18 @@
 #include <ssa/value/basicBlock.hh>
 #include <ssa/value/global/function.hh>
-#include <ssa/value/instruction/return.hh>
 
 namespace SSA
 {
-    BasicBlock* BasicBlock::Create(Module& module, Function* parent, const std::string& name)
+    BasicBlock* BasicBlock::Create(Module& module, Function* parent)
     {
-        BasicBlock* bb = new BasicBlock(module, parent, name);
+        BasicBlock* bb = module.GetArena().Create<BasicBlock>(module, parent);
         
         return bb;
     }
 
-    BasicBlock::BasicBlock(Module& module, Function* parent, const std::string& name)
-        :Value(module), _name(name), _parent(parent)
+    BasicBlock::BasicBlock(Module& module, Function* parent)
+        :Value(module), _parent(parent), _first(nullptr), _last(nullptr)
     {
-        if(_name == "")
-        {
-            _name = std::to_string(module.GetNextInstName());
-        }
-
         if(parent)
             parent->GetBasicBlockList().push_back(this);
     }
@@ -28,45 +22,73 @@ namespace SSA
         return _parent;
     }
 
-    std::vector<Instruction*>& BasicBlock::GetInstList()
+    Instruction* BasicBlock::GetFirst() const
     {
-        return _instList;
+        return _first;
     }
 
-    void BasicBlock::Print(std::ostream& stream, int indent) const
+    Instruction* BasicBlock::GetLast() const
     {
-        stream << _name << ":";
-        stream << "\n";
-        for(Instruction* inst : _instList)
-        {
-            inst->Print(stream, indent);
-            if(inst->GetInstType() == Instruction::Ret)
-                break;
-        }
+        return _last;
     }
 
-    std::string BasicBlock::GetID() const
+    void BasicBlock::Append(Instruction* inst)
     {
-        return _name;
+        inst->_parent = this;
+        inst->_prev = _last;
+        inst->_next = nullptr;
+        if(_last)
+            _last->_next = inst;
+        else
+            _first = inst;
+        _last = inst;
     }
 
-    Codegen::Value* BasicBlock::Emit(Codegen::Assembly& assembly)
+    void BasicBlock::InsertBefore(Instruction* inst, Instruction* before)
     {
-        for(Instruction* inst : _instList)
+        if(!before)
         {
-            inst->Emit(assembly);
-            if(inst->GetInstType() == Instruction::Ret)
-                break;
+            Append(inst);
+            return;
         }
+        inst->_parent = this;
+        inst->_prev = before->_prev;
+        inst->_next = before;
+        if(before->_prev)
+            before->_prev->_next = inst;
+        else
+            _first = inst;
+        before->_prev = inst;
+    }
 
-        return nullptr;
+    void BasicBlock::Remove(Instruction* inst)
+    {
+        if(inst->_prev)
+            inst->_prev->_next = inst->_next;
+        else
+            _first = inst->_next;
+        if(inst->_next)
+            inst->_next->_prev = inst->_prev;
+        else
+            _last = inst->_prev;
+        inst->_parent = nullptr;
+        inst->_prev = nullptr;
+        inst->_next = nullptr;
     }
 
-    void BasicBlock::Dispose()
+    void BasicBlock::Print(std::ostream& stream, int indent) const
     {
-        for(Instruction* inst : _instList)
-            inst->Dispose();
-        
-        delete this;
+        stream << GetID() << ":";
+        stream << "\n";
+        for(Instruction* inst = _first; inst; inst = inst->GetNext())
+            inst->Print(stream, indent);
+    }
+
+    Codegen::Value* BasicBlock::Emit(Codegen::Assembly& assembly)
+    {
+        for(Instruction* inst = _first; inst; inst = inst->GetNext())
+            inst->Emit(assembly);
+
+        return nullptr;
     }
 }
\ No newline at end of file
@@ -2,19 +2,19 @@
 
 namespace SSA
 {
-    IntegerLiteral::IntegerLiteral(Module& module, long long value)
+    IntegerLiteral::IntegerLiteral(Module& module, long long value, const Type* type)
         :Value(module), _value(value)
     {
-        _type = types.at("int64");
+        _type = type;
     }
 
     void IntegerLiteral::Print(std::ostream&, int) const
     {
     }
 
-    std::string IntegerLiteral::GetID() const
+    void IntegerLiteral::PrintID(std::ostream& stream) const
     {
-        return "int32 " + std::to_string(_value);
+        stream << "int" << _type->GetScalarSize() << ' ' << _value;
     }
 
     long long IntegerLiteral::GetValue() const
@@ -1,18 +1,20 @@
 #include <ssa/value/global/function.hh>
+#include <codegen/value/stackSlot.hh>
 #include <algorithm>
+#include <cassert>
 
 namespace SSA
 {
-    Function* Function::Create(Module& module, const std::string& name)
+    Function* Function::Create(Module& module, Atom name)
     {
         Function* func = new Function(module, name);
 
-        module.GetGlobals().push_back(func);
+        module.AddFunction(func);
 
         return func;
     }
 
-    Function::Function(Module& module, const std::string& name)
+    Function::Function(Module& module, Atom name)
         :Value(module), _name(name), _totalAllocaOffset(0)
     {
     }
@@ -27,6 +29,49 @@ namespace SSA
         return _allocaList;
     }
 
+    std::uint32_t Function::GetLocalValueCount() const
+    {
+        return GetModule().GetValueCount() - GetID();
+    }
+
+    std::uint32_t Function::GetLocalID(const Value* value) const
+    {
+        assert(value->GetID() > GetID() && value->GetID() < GetModule().GetValueCount());
+        return value->GetID() - GetID();
+    }
+
+    std::vector<Instruction*> Function::GetInstructionsInPostOrder()
+    {
+        std::vector<bool> visited(GetLocalValueCount());
+        std::vector<Instruction*> order;
+        std::vector<std::pair<Instruction*, unsigned int>> stack;
+        for(BasicBlock* bb : _basicBlockList)
+        {
+            for(Instruction* inst = bb->GetFirst(); inst; inst = inst->GetNext())
+            {
+                stack.emplace_back(inst, 0);
+                visited[GetLocalID(inst)] = true;
+                while(!stack.empty())
+                {
+                    auto& [user, index] = stack.back();
+                    if(index == user->GetOperandCount())
+                    {
+                        order.push_back(user);
+                        stack.pop_back();
+                        continue;
+                    }
+                    Instruction* operand = dynamic_cast<Instruction*>(user->GetOperand(index++));
+                    if(operand && !visited[GetLocalID(operand)])
+                    {
+                        visited[GetLocalID(operand)] = true;
+                        stack.emplace_back(operand, 0);
+                    }
+                }
+            }
+        }
+        return order;
+    }
+
     void Function::Print(std::ostream& stream, int indent) const
     {
         stream << std::string(indent, ' ') << "define int32 " << _name << "() {\n";
@@ -37,12 +82,17 @@ namespace SSA
         stream << std::string(indent, ' ') << "}";
     }
 
-    std::string Function::GetID() const
+    void Function::PrintID(std::ostream& stream) const
     {
-        return "%" + _name;
+        stream << "%" << _name;
     }
 
     std::string_view Function::GetName() const
+    {
+        return _name.GetName();
+    }
+
+    Atom Function::GetAtom() const
     {
         return _name;
     }
@@ -50,14 +100,23 @@ namespace SSA
     Codegen::Value* Function::Emit(Codegen::Assembly& assembly)
     {
         SortAllocas();
-        assembly.CreateGlobal(_name);
-        assembly.CreateLabel(_name);
+        Codegen::Register::FreeAllRegisters();
+        Codegen::StackSlot::FreeAllSlots(_totalAllocaOffset);
+        assembly.CreateGlobal(GetName());
+        assembly.CreateLabel(GetName());
+
+        // The frame also holds the registers the body spills, so its size
+        // is only known once the body is emitted
+        Codegen::Assembly body;
+        for(BasicBlock* bb : _basicBlockList)
+            bb->Emit(body);
+        int frameSize = (Codegen::StackSlot::GetFrameSize() + 15) & ~15;
 
-        if(_totalAllocaOffset)
+        if(frameSize)
         {
             Codegen::Register* rbp = Codegen::Register::GetRegister("rbp");
             Codegen::Register* rsp = Codegen::Register::GetRegister("rsp");
-            Codegen::ImmediateValue* rspOffset = new Codegen::ImmediateValue(_totalAllocaOffset, types.at("int64"));
+            Codegen::ImmediateValue* rspOffset = new Codegen::ImmediateValue(frameSize, TypeContext::GetIntegerType(64));
 
             assembly.CreatePush(rbp);
             assembly.CreateMov(rbp, rsp);
@@ -66,27 +125,16 @@ namespace SSA
             rspOffset->Dispose();
         }
 
-        for(BasicBlock* bb : _basicBlockList)
-            bb->Emit(assembly);
+        assembly.Append(body);
 
         assembly.CreateLabel(".ret");
-        if(_totalAllocaOffset)
+        if(frameSize)
             assembly.CreateLeave();
         assembly.CreateRet();
 
         return nullptr;
     }
 
-    void Function::Dispose()
-    {
-        for(BasicBlock* basicBlock : _basicBlockList)
-            basicBlock->Dispose();
-        for(AllocaInst* alloca : _allocaList)
-            alloca->Dispose();
-
-        delete this;
-    }
-
     void Function::SortAllocas()
     {
         std::sort(_allocaList.begin(), _allocaList.end(), [](AllocaInst* lhs, AllocaInst* rhs) {
@@ -1,40 +1,46 @@
 #include <ssa/value/instruction/alloca.hh>
+#include <ssa/value/instruction/store.hh>
 #include <iostream>
 namespace SSA
 {
-    AllocaInst::AllocaInst(Module& module, std::shared_ptr<Type> allocatedType, const std::string& name)
-        :Instruction(module), _name(new TempValue(module, name)), _memory(nullptr), _allocatedType(allocatedType)
+    AllocaInst::AllocaInst(Module& module, const Type* allocatedType)
+        :Instruction(module, 0), _allocatedType(allocatedType)
     {
         _instType = Instruction::Alloca;
     }
 
     void AllocaInst::Print(std::ostream& stream, int indent) const
     {
-        _name->Print(stream, indent);
+        PrintResult(stream, indent);
         stream << "alloca int32\n";
     }
 
-    std::string AllocaInst::GetID() const
+    void AllocaInst::PrintID(std::ostream& stream) const
     {
-        return "int32* " + _name->GetID();
+        stream << "int32* %" << GetID();
     }
 
     Codegen::Value* AllocaInst::Emit(Codegen::Assembly&)
     {
-        if(!_memory)
-            _memory = new Codegen::MemoryValue(_offset, false, _allocatedType);
-        return _memory;
+        return new Codegen::MemoryValue(_offset, false, _allocatedType);
     }
 
-    void AllocaInst::Dispose()
+    const Type* AllocaInst::GetAllocatedType() const
     {
-        _name->Dispose();
-        delete _memory;
-        delete this;
+        return _allocatedType;
     }
 
-    std::shared_ptr<Type> AllocaInst::GetAllocatedType() const
+    bool AllocaInst::IsPromotable() const
     {
-        return _allocatedType;
+        for(Use* use = GetFirstUse(); use; use = use->GetNext())
+        {
+            Instruction* user = use->GetUser();
+            if(user->GetInstType() == Instruction::Load)
+                continue;
+            if(user->GetInstType() == Instruction::Store && static_cast<StoreInst*>(user)->GetValue() != this)
+                continue;
+            return false;
+        }
+        return true;
     }
 }
\ No newline at end of file
@@ -1,9 +1,31 @@
 #include <ssa/value/instruction/binOp.hh>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 
 namespace SSA
 {
-    BinOp::BinOp(Module& module, InstType type, Value* lhs, Value* rhs, const std::string& name)
-        :Instruction(module), _name(new TempValue(module, name)), _lhs(lhs), _rhs(rhs)
+    BinOp::BinOp(Module& module, InstType type, Value* lhs, Value* rhs)
+        :Instruction(module, 2)
+    {
+        _instType = type;
+        SetOperand(0, lhs);
+        SetOperand(1, rhs);
+        _type = GetResultType(lhs, rhs);
+    }
+
+    Value* BinOp::GetLHS() const
+    {
+        return GetOperand(0);
+    }
+
+    Value* BinOp::GetRHS() const
+    {
+        return GetOperand(1);
+    }
+
+    void BinOp::SetInstType(InstType type)
     {
         _instType = type;
     }
@@ -25,49 +47,170 @@ namespace SSA
         }
     }
 
-    std::string BinOp::GetID() const
+    void BinOp::Print(std::ostream& stream, int indent) const
+    {
+        GetLHS()->Print(stream, indent);
+        GetRHS()->Print(stream, indent);
+
+        PrintResult(stream, indent);
+        stream << InstTypeToString(_instType) << " ";
+        GetLHS()->PrintID(stream);
+        stream << ", ";
+        GetRHS()->PrintID(stream);
+        stream << "\n";
+    }
+
+    bool BinOp::IsAssociative(InstType type)
     {
-        return _name->GetID();
+        return type == Add || type == Mul;
     }
 
-    void BinOp::Print(std::ostream& stream, int indent) const
+    bool BinOp::IsCommutative(InstType type)
+    {
+        return type == Add || type == Mul;
+    }
+
+    const Type* BinOp::GetResultType(Value* lhs, Value* rhs)
     {
-        _lhs->Print(stream, indent);
-        _rhs->Print(stream, indent);
+        const Type* lhsType = lhs ? lhs->GetType() : nullptr;
+        const Type* rhsType = rhs ? rhs->GetType() : nullptr;
+        if(lhsType && rhsType)
+            return lhsType->GetScalarSize() >= rhsType->GetScalarSize() ? lhsType : rhsType;
+        if(lhsType || rhsType)
+            return lhsType ? lhsType : rhsType;
+        return TypeContext::GetIntegerType(64);
+    }
 
-        _name->Print(stream, indent);
-        stream << InstTypeToString(_instType) << " " << _lhs->GetID() << ", " << _rhs->GetID() << "\n";
+    static unsigned int GetRegisterNeed(const std::unordered_map<const BinOp*, unsigned int>& needs, Value* operand)
+    {
+        auto need = needs.find(dynamic_cast<const BinOp*>(operand));
+        return need == needs.end() ? 1 : need->second;
     }
 
-    constexpr bool IsNoAssoc(BinOp::InstType type)
+    // The registers each operation under root that is still to be emitted
+    // needs when the operand needing more is evaluated first
+    static std::unordered_map<const BinOp*, unsigned int> GetRegisterNeeds(BinOp* root)
     {
-        switch(type)
+        std::unordered_map<const BinOp*, unsigned int> needs;
+        std::vector<std::pair<BinOp*, bool>> stack = { { root, false } };
+        while(!stack.empty())
         {
-            case BinOp::Add:
-            case BinOp::Mul:
-                return true;
-            case BinOp::Sub:
-            case BinOp::Div:
-                return false;
-            default:
-                throw;
+            auto [binop, visited] = stack.back();
+            stack.pop_back();
+            if(visited)
+            {
+                unsigned int lhs = GetRegisterNeed(needs, binop->GetLHS());
+                unsigned int rhs = GetRegisterNeed(needs, binop->GetRHS());
+                needs[binop] = lhs == rhs ? lhs + 1 : std::max(lhs, rhs);
+                continue;
+            }
+            // An operation several others share is only walked once
+            if(!needs.emplace(binop, 0).second)
+                continue;
+            stack.push_back({ binop, true });
+            for(Value* operand : { binop->GetLHS(), binop->GetRHS() })
+            {
+                BinOp* nested = dynamic_cast<BinOp*>(operand);
+                if(nested && !nested->IsEmitted())
+                    stack.push_back({ nested, false });
+            }
         }
+        return needs;
     }
 
+    // Trees of operations are as deep as the expressions they came from, so
+    // nested operations are emitted with an explicit stack. An operation an
+    // earlier user already emitted is an operand like any other. Operands
+    // have no side effects, so the one needing more registers goes first
     Codegen::Value* BinOp::Emit(Codegen::Assembly& assembly)
     {
-        Codegen::Value* lhs = _lhs->Emit(assembly);
-        Codegen::Value* rhs = _rhs->Emit(assembly);
+        struct Frame
+        {
+            BinOp* binop;
+            bool rhsFirst;
+            Codegen::Value* first;
+            int state;
+        };
+        std::unordered_map<const BinOp*, unsigned int> needs = GetRegisterNeeds(this);
+        std::deque<Frame> stack = { { this, false, nullptr, 0 } };
+        Codegen::Value* result = nullptr;
+        while(true)
+        {
+            Frame& frame = stack.back();
+            BinOp* binop = frame.binop;
+            Value* operand;
+            switch(frame.state++)
+            {
+                case 0:
+                    frame.rhsFirst = GetRegisterNeed(needs, binop->GetRHS()) > GetRegisterNeed(needs, binop->GetLHS());
+                    operand = frame.rhsFirst ? binop->GetRHS() : binop->GetLHS();
+                    break;
+                case 1:
+                    // The first operand may be spilled while the second is
+                    // evaluated
+                    frame.first = result;
+                    Codegen::Register::Hold(&frame.first);
+                    operand = frame.rhsFirst ? binop->GetLHS() : binop->GetRHS();
+                    break;
+                default:
+                {
+                    Codegen::Register::Release(&frame.first);
+                    if(frame.rhsFirst)
+                        result = binop->EmitOperation(assembly, result, frame.first);
+                    else
+                        result = binop->EmitOperation(assembly, frame.first, result);
+                    stack.pop_back();
+                    if(stack.empty())
+                        return result;
+                    result = binop->KeepForUsers(result);
+                    continue;
+                }
+            }
+
+            BinOp* nested = dynamic_cast<BinOp*>(operand);
+            if(nested && !nested->IsEmitted())
+                stack.push_back({ nested, false, nullptr, 0 });
+            else
+                result = operand->EmitUse(assembly);
+        }
+    }
+
+    Codegen::Value* BinOp::EmitOperation(Codegen::Assembly& assembly, Codegen::Value* lhs, Codegen::Value* rhs)
+    {
+        if(_instType == Instruction::Div)
+            return EmitDivision(assembly, lhs, rhs);
 
-        if(!lhs->IsRegister())
+        // The result overwrites the left operand, which therefore has to be
+        // a register that no other user still reads. Only the low bits of a
+        // register are significant for its value's type, so an operand
+        // narrower than the operation is sign-extended first
+        int bits = _type->GetScalarSize();
+        int lhsBits = GetLHS()->GetType()->GetScalarSize();
+        int rhsBits = GetRHS()->GetType()->GetScalarSize();
+        if(!lhs->IsRegister() || Codegen::Register::IsShared(static_cast<Codegen::Register*>(lhs)))
         {
-            Codegen::Register* reg = Codegen::Register::AllocRegister(Codegen::RegisterType::Integral);
-            assembly.CreateMov(reg, lhs);
+            Codegen::Register* reg = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+            assembly.CreateMovsx(reg, lhs, bits, lhsBits);
             lhs->Dispose();
             lhs = reg;
         }
+        else if(lhsBits < bits)
+            assembly.CreateMovsx(lhs, lhs, bits, lhsBits);
 
-        Codegen::Value* result = lhs;
+        if(rhs->IsRegister() && !Codegen::Register::IsShared(static_cast<Codegen::Register*>(rhs)))
+        {
+            if(rhsBits < bits)
+                assembly.CreateMovsx(rhs, rhs, bits, rhsBits);
+        }
+        // imul has no two-operand form for bytes, so a byte in memory is
+        // loaded into a register too
+        else if(!rhs->IsImmediate() && (rhsBits < bits || (rhs->IsMemory() && _instType == Instruction::Mul && bits == 8)))
+        {
+            Codegen::Register* reg = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+            assembly.CreateMovsx(reg, rhs, bits, rhsBits);
+            rhs->Dispose();
+            rhs = reg;
+        }
 
         switch(_instType)
         {
@@ -86,14 +229,55 @@ namespace SSA
 
         rhs->Dispose();
 
-        return result;
+        return lhs;
     }
 
-    void BinOp::Dispose()
+    // idiv divides rdx:rax by its operand and leaves the quotient in rax, so
+    // the division takes both registers and saves whatever else they hold
+    Codegen::Value* BinOp::EmitDivision(Codegen::Assembly& assembly, Codegen::Value* lhs, Codegen::Value* rhs)
     {
-        _lhs->Dispose();
-        _rhs->Dispose();
-        _name->Dispose();
-        delete this;
+        int bits = _type->GetScalarSize();
+        Codegen::Register* rax = Codegen::Register::GetRegister("rax");
+        Codegen::Register* rdx = Codegen::Register::GetRegister("rdx");
+
+        Codegen::Value* divisor = rhs;
+        int rhsBits = GetRHS()->GetType()->GetScalarSize();
+        if(rhs->IsImmediate() || rhs == rax || rhs == rdx || rhsBits != bits)
+        {
+            Codegen::Register* reg = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+            assembly.CreateMovsx(reg, rhs, bits, rhsBits);
+            rhs->Dispose();
+            divisor = reg;
+        }
+
+        bool saveRax = Codegen::Register::GetReferenceCount(rax) > 1u + (lhs == rax);
+        bool saveRdx = Codegen::Register::GetReferenceCount(rdx) > 1u + (lhs == rdx);
+        if(saveRax)
+            assembly.CreatePush(rax);
+        if(saveRdx)
+            assembly.CreatePush(rdx);
+
+        assembly.CreateMovsx(rax, lhs, bits, GetLHS()->GetType()->GetScalarSize());
+        assembly.CreateCqo(bits);
+        assembly.CreateDiv(divisor, bits);
+
+        lhs->Dispose();
+        divisor->Dispose();
+        rdx->Dispose();
+
+        Codegen::Register* result = rax;
+        if(saveRax)
+        {
+            result = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+            assembly.CreateMov(result, rax);
+            rax->Dispose();
+        }
+
+        if(saveRdx)
+            assembly.CreatePop(rdx);
+        if(saveRax)
+            assembly.CreatePop(rax);
+
+        return result;
     }
 }
\ No newline at end of file
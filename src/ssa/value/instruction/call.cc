@@ -1,36 +1,58 @@
 #include <ssa/value/instruction/call.hh>
 #include <ssa/value/global/function.hh>
 #include <environment.hh>
+#include <algorithm>
 
 namespace SSA
 {
-    CallInst::CallInst(Module& module, Function* callee, const std::string& name)
-        :Instruction(module), _name(new TempValue(module, name)), _callee(callee)
+    CallInst::CallInst(Module& module, Function* callee)
+        :Instruction(module, 0), _callee(callee)
     {
-        _instType = Instruction::Load;
+        _instType = Instruction::Call;
+        // Every function returns int32 for now
+        _type = TypeContext::GetIntegerType(32);
     }
 
-    std::string CallInst::GetID() const
+    Function* CallInst::GetCallee() const
     {
-        return _name->GetID();
+        return _callee;
     }
 
     void CallInst::Print(std::ostream& stream, int indent) const
     {
-        _name->Print(stream, indent);
-        stream << "call int32 " << _callee->GetID() << '\n';
+        PrintResult(stream, indent);
+        stream << "call int32 ";
+        _callee->PrintID(stream);
+        stream << '\n';
     }
 
     Codegen::Value* CallInst::Emit(Codegen::Assembly& assembly)
     {
+        // The callee may use any register, so the ones that still hold
+        // values are saved around the call. The result is moved out of rax
+        // when rax is one of them, into a register taken before the pushes
+        // in case taking it spills another
+        Codegen::Register* rax = Codegen::Register::GetRegister("rax");
+        Codegen::Register* result = rax;
+        if(Codegen::Register::IsShared(rax))
+            result = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+
+        std::vector<Codegen::Register*> live = Codegen::Register::GetLiveRegisters(Codegen::RegisterType::Integral);
+        live.erase(std::remove(live.begin(), live.end(), result), live.end());
+        for(Codegen::Register* reg : live)
+            assembly.CreatePush(reg);
+
         assembly.CreateCall(_callee->GetName());
-        
-        return Codegen::Register::GetRegister("rax");
-    }
 
-    void CallInst::Dispose()
-    {
-        _name->Dispose();
-        delete this;
+        if(result != rax)
+        {
+            assembly.CreateMov(result, rax);
+            rax->Dispose();
+        }
+
+        for(auto reg = live.rbegin(); reg != live.rend(); ++reg)
+            assembly.CreatePop(*reg);
+
+        return result;
     }
 }
\ No newline at end of file
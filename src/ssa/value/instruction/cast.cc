@@ -0,0 +1,50 @@
+#include <ssa/value/instruction/cast.hh>
+
+namespace SSA
+{
+    CastInst::CastInst(Module& module, Value* value, const Type* type)
+        :Instruction(module, 1)
+    {
+        _instType = Instruction::Cast;
+        _type = type;
+        SetOperand(0, value);
+    }
+
+    Value* CastInst::GetValue() const
+    {
+        return GetOperand(0);
+    }
+
+    void CastInst::Print(std::ostream& stream, int indent) const
+    {
+        GetValue()->Print(stream, indent);
+
+        PrintResult(stream, indent);
+        stream << "cast int" << _type->GetScalarSize() << ", ";
+        GetValue()->PrintID(stream);
+        stream << '\n';
+    }
+
+    // Only the low bits of a register are significant for a value's type,
+    // so a wider value is already its truncation. A narrower one is
+    // sign-extended into a register of its own unless no one else reads it
+    Codegen::Value* CastInst::Emit(Codegen::Assembly& assembly)
+    {
+        Codegen::Value* value = GetValue()->EmitUse(assembly);
+        int bits = _type->GetScalarSize();
+        int valueBits = GetValue()->GetType()->GetScalarSize();
+        if(valueBits >= bits || value->IsImmediate())
+            return value;
+
+        if(value->IsRegister() && !Codegen::Register::IsShared(static_cast<Codegen::Register*>(value)))
+        {
+            assembly.CreateMovsx(value, value, bits, valueBits);
+            return value;
+        }
+
+        Codegen::Register* reg = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+        assembly.CreateMovsx(reg, value, bits, valueBits);
+        value->Dispose();
+        return reg;
+    }
+}
\ No newline at end of file
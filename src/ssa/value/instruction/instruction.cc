@@ -0,0 +1,39 @@
+#include <ssa/value/instruction/instruction.hh>
+#include <ssa/value/basicBlock.hh>
+
+namespace SSA
+{
+    Instruction::Instruction(Module& module, unsigned int operandCount)
+        :Value(module), _operands(module.GetArena().CreateArray<Use>(operandCount)), _operandCount(operandCount),
+        _parent(nullptr), _prev(nullptr), _next(nullptr)
+    {
+        for(unsigned int i = 0; i < operandCount; ++i)
+            _operands[i]._user = this;
+    }
+
+    void Instruction::EraseFromParent()
+    {
+        if(_parent)
+            _parent->Remove(this);
+        for(unsigned int i = 0; i < _operandCount; ++i)
+            _operands[i].Set(nullptr);
+    }
+
+    void EraseDeadInstructions(std::vector<Instruction*>& worklist)
+    {
+        while(!worklist.empty())
+        {
+            Instruction* inst = worklist.back();
+            worklist.pop_back();
+            if(inst->HasUses() || inst->GetParent())
+                continue;
+
+            for(unsigned int i = 0; i < inst->GetOperandCount(); ++i)
+            {
+                if(Instruction* operand = dynamic_cast<Instruction*>(inst->GetOperand(i)))
+                    worklist.push_back(operand);
+            }
+            inst->EraseFromParent();
+        }
+    }
+}
@@ -1,39 +1,46 @@
 #include <ssa/value/instruction/load.hh>
+#include <ssa/value/instruction/alloca.hh>
 #include <environment.hh>
 
 namespace SSA
 {
-    LoadInst::LoadInst(Module& module, Value* ptr, const std::string& name)
-        :Instruction(module), _name(new TempValue(module, name)), _ptr(ptr)
+    LoadInst::LoadInst(Module& module, Value* ptr)
+        :Instruction(module, 1)
     {
         _instType = Instruction::Load;
+        SetOperand(0, ptr);
+        if(AllocaInst* alloca = dynamic_cast<AllocaInst*>(ptr))
+            _type = alloca->GetAllocatedType();
     }
 
-    std::string LoadInst::GetID() const
+    Value* LoadInst::GetPointer() const
     {
-        return _name->GetID();
+        return GetOperand(0);
     }
 
     void LoadInst::Print(std::ostream& stream, int indent) const
     {
-        _name->Print(stream, indent);
-        stream << "load int32, " << _ptr->GetID() << '\n';
+        PrintResult(stream, indent);
+        stream << "load int32, ";
+        GetPointer()->PrintID(stream);
+        stream << '\n';
     }
 
     Codegen::Value* LoadInst::Emit(Codegen::Assembly& assembly)
     {
-        Codegen::Value* ptr = _ptr->Emit(assembly);
-        _memory = new Codegen::MemoryValue(static_cast<Codegen::MemoryValue*>(ptr), true);
+        Codegen::Value* ptr = GetPointer()->EmitUse(assembly);
+        Codegen::Value* memory = new Codegen::MemoryValue(static_cast<Codegen::MemoryValue*>(ptr), true);
 
         ptr->Dispose();
 
-        return _memory;
-    }
-
-    void LoadInst::Dispose()
-    {
-        _name->Dispose();
-        delete _memory;
-        delete this;
+        // A load with several users is read from memory once
+        if(HasUses() && GetFirstUse()->GetNext())
+        {
+            Codegen::Register* reg = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
+            assembly.CreateMov(reg, memory);
+            memory->Dispose();
+            return reg;
+        }
+        return memory;
     }
 }
\ No newline at end of file
@@ -4,18 +4,24 @@
 namespace SSA
 {
     RetInst::RetInst(Module& module, Value* value)
-        :Instruction(module), _value(value)
+        :Instruction(module, 1)
     {
         _instType = Instruction::Ret;
+        SetOperand(0, value);
+    }
+
+    Value* RetInst::GetValue() const
+    {
+        return GetOperand(0);
     }
 
     void RetInst::Print(std::ostream& stream, int indent) const
     {
-        if(_value)
-            _value->Print(stream, indent);
+        if(GetValue())
+            GetValue()->Print(stream, indent);
         stream << std::string(indent, ' ') << "ret ";
-        if(_value)
-            stream << _value->GetID();
+        if(GetValue())
+            GetValue()->PrintID(stream);
         else
             stream << "void";
         
@@ -24,25 +30,19 @@ namespace SSA
 
     Codegen::Value* RetInst::Emit(Codegen::Assembly& assembly)
     {
-        if(_value)
+        if(GetValue())
         {
-            Codegen::Value* value = _value->Emit(assembly);
+            Codegen::Value* value = GetValue()->EmitUse(assembly);
             Codegen::Value* rax = Codegen::Register::GetRegister("rax");
 
-            assembly.CreateMov(rax, std::move(value));
+            assembly.CreateMovsx(rax, value, 64, GetValue()->GetType()->GetScalarSize());
 
             value->Dispose();
+            rax->Dispose();
         }
         
         assembly.CreateJmp(".ret");
 
         return nullptr;
     }
-
-    void RetInst::Dispose()
-    {
-        if(_value)
-            _value->Dispose();
-        delete this;
-    }
 }
\ No newline at end of file
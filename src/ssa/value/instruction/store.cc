@@ -4,23 +4,39 @@
 namespace SSA
 {
     StoreInst::StoreInst(Module& module, Value* ptr, Value* value)
-        :Instruction(module), _ptr(ptr), _value(value)
+        :Instruction(module, 2)
     {
         _instType = Instruction::Store;
+        SetOperand(0, ptr);
+        SetOperand(1, value);
+    }
+
+    Value* StoreInst::GetPointer() const
+    {
+        return GetOperand(0);
+    }
+
+    Value* StoreInst::GetValue() const
+    {
+        return GetOperand(1);
     }
 
     void StoreInst::Print(std::ostream& stream, int indent) const
     {
-        stream << std::string(indent, ' ') << "store " << _value->GetID() << ", " << _ptr->GetID() << '\n';
+        stream << std::string(indent, ' ') << "store ";
+        GetValue()->PrintID(stream);
+        stream << ", ";
+        GetPointer()->PrintID(stream);
+        stream << '\n';
     }
 
     Codegen::Value* StoreInst::Emit(Codegen::Assembly& assembly)
     {
-        Codegen::Value* ptr = _ptr->Emit(assembly);
-        Codegen::Value* value = _value->Emit(assembly);
+        Codegen::Value* ptr = GetPointer()->EmitUse(assembly);
+        Codegen::Value* value = GetValue()->EmitUse(assembly);
         if(value->IsMemory())
         {
-            Codegen::Register* reg = Codegen::Register::AllocRegister(Codegen::RegisterType::Integral);
+            Codegen::Register* reg = Codegen::Register::AllocRegister(assembly, Codegen::RegisterType::Integral);
             assembly.CreateMov(reg, value);
             value->Dispose();
             value = reg;
@@ -28,14 +44,9 @@ namespace SSA
         
         assembly.CreateMov(ptr, value);
 
+        ptr->Dispose();
         value->Dispose();
 
         return value;
     }
-
-    void StoreInst::Dispose()
-    {
-        _value->Dispose();
-        delete this;
-    }
 }
\ No newline at end of file
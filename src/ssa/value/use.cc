@@ -0,0 +1,57 @@
+#include <ssa/value/use.hh>
+#include <ssa/value/value.hh>
+
+namespace SSA
+{
+    Use::Use()
+        :_value(nullptr), _user(nullptr), _prev(nullptr), _next(nullptr)
+    {
+    }
+
+    Value* Use::Get() const
+    {
+        return _value;
+    }
+
+    void Use::Set(Value* value)
+    {
+        if(_value)
+        {
+            if(_prev)
+                _prev->_next = _next;
+            else
+                _value->_firstUse = _next;
+            if(_next)
+                _next->_prev = _prev;
+        }
+
+        _value = value;
+        _prev = nullptr;
+        _next = nullptr;
+        if(_value)
+        {
+            _next = _value->_firstUse;
+            if(_next)
+                _next->_prev = this;
+            _value->_firstUse = this;
+        }
+    }
+
+    void Value::ReplaceAllUsesWith(Value* value)
+    {
+        if(value == this)
+            return;
+        while(_firstUse)
+            _firstUse->Set(value);
+    }
+
+    Instruction* Use::GetUser() const
+    {
+        return _user;
+    }
+
+    Use* Use::GetNext() const
+    {
+        return _next;
+    }
+}
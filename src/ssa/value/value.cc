@@ -0,0 +1,40 @@
+#include <ssa/value/value.hh>
+
+namespace SSA
+{
+    Codegen::Value* Value::EmitUse(Codegen::Assembly& assembly)
+    {
+        if(_emitted)
+        {
+            Codegen::Value* emitted = _emitted;
+            if(!--_pendingUses)
+            {
+                Codegen::Register::Release(&_emitted);
+                _emitted = nullptr;
+            }
+            return emitted;
+        }
+
+        return KeepForUsers(Emit(assembly));
+    }
+
+    Codegen::Value* Value::KeepForUsers(Codegen::Value* result)
+    {
+        // Only a register needs to be kept for later users. Constants are
+        // shared by the whole module, so their use lists are long
+        if(!result->IsRegister())
+            return result;
+
+        unsigned int useCount = 0;
+        for(Use* use = _firstUse; use; use = use->GetNext())
+            ++useCount;
+        if(useCount > 1)
+        {
+            Codegen::Register::RetainRegister(static_cast<Codegen::Register*>(result), useCount - 1);
+            _emitted = result;
+            _pendingUses = useCount - 1;
+            Codegen::Register::Hold(&_emitted, &_pendingUses);
+        }
+        return result;
+    }
+}
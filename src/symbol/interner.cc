@@ -0,0 +1,86 @@
+#include <symbol/interner.hh>
+#include <diagnostics.hh>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Interner
+{
+    // An atom's low bits select the shard, the rest is its index within the shard plus one
+    constexpr unsigned int shardBits = 4;
+    constexpr unsigned int shardCount = 1 << shardBits;
+    constexpr std::size_t blockSize = 16 * 1024;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string_view, std::uint32_t> atoms;
+        std::vector<std::string_view> names;
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char* blockPos = nullptr;
+        std::size_t blockLeft = 0;
+
+        std::string_view Store(std::string_view name)
+        {
+            if(name.length() > blockLeft)
+            {
+                std::size_t size = std::max(blockSize, name.length());
+                blocks.push_back(std::make_unique<char[]>(size));
+                blockPos = blocks.back().get();
+                blockLeft = size;
+            }
+            std::copy(name.begin(), name.end(), blockPos);
+            std::string_view stored(blockPos, name.length());
+            blockPos += name.length();
+            blockLeft -= name.length();
+            return stored;
+        }
+    };
+
+    static std::array<Shard, shardCount> shards;
+
+    Atom Intern(std::string_view name)
+    {
+        std::size_t hash = std::hash<std::string_view>()(name);
+        unsigned int shardIndex = hash >> (sizeof(std::size_t) * 8 - shardBits);
+        Shard& shard = shards[shardIndex];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.atoms.find(name);
+        if(it != shard.atoms.end())
+            return Atom(it->second);
+
+        if(shard.names.size() >= (UINT32_MAX >> shardBits) - 1)
+            Diagnostics::FatalError("viper", "too many unique identifiers");
+
+        std::string_view stored = shard.Store(name);
+        shard.names.push_back(stored);
+        std::uint32_t id = static_cast<std::uint32_t>(shard.names.size()) << shardBits | shardIndex;
+        shard.atoms.emplace(stored, id);
+        return Atom(id);
+    }
+
+    std::string_view GetName(Atom atom)
+    {
+        if(!atom.IsValid())
+            return {};
+
+        Shard& shard = shards[atom.GetID() & (shardCount - 1)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.names[(atom.GetID() >> shardBits) - 1];
+    }
+}
+
+std::string_view Atom::GetName() const
+{
+    return Interner::GetName(*this);
+}
+
+std::ostream& operator<<(std::ostream& stream, Atom atom)
+{
+    return stream << atom.GetName();
+}
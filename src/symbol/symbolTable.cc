@@ -0,0 +1,53 @@
+#include <symbol/symbolTable.hh>
+
+SymbolTable::SymbolTable()
+    :_nextID(0)
+{
+}
+
+void SymbolTable::PushScope()
+{
+    _scopes.push_back(_entries.size());
+}
+
+void SymbolTable::PopScope()
+{
+    std::size_t start = _scopes.back();
+    _scopes.pop_back();
+
+    while(_entries.size() > start)
+    {
+        Entry& entry = _entries.back();
+        if(entry.shadowed == NoEntry)
+            _bindings.erase(entry.symbol.GetName());
+        else
+            _bindings[entry.symbol.GetName()] = entry.shadowed;
+        _entries.pop_back();
+    }
+}
+
+void SymbolTable::Reset()
+{
+    _entries.clear();
+    _scopes.clear();
+    _bindings.clear();
+    _nextID = 0;
+}
+
+VarSymbol* SymbolTable::Declare(Atom name, const Type* type)
+{
+    auto [it, inserted] = _bindings.try_emplace(name, NoEntry);
+    std::uint32_t shadowed = inserted ? NoEntry : it->second;
+    it->second = _entries.size();
+
+    _entries.push_back({ VarSymbol(name, _nextID++, type), shadowed });
+    return &_entries.back().symbol;
+}
+
+VarSymbol* SymbolTable::Find(Atom name)
+{
+    auto it = _bindings.find(name);
+    if(it == _bindings.end())
+        return nullptr;
+    return &_entries[it->second].symbol;
+}
@@ -1,16 +1,21 @@
 #include <symbol/varSymbol.hh>
 
-VarSymbol::VarSymbol(const std::string& name, std::shared_ptr<Type> type)
-    :_name(name), _type(type)
+VarSymbol::VarSymbol(Atom name, std::uint32_t id, const Type* type)
+    :_name(name), _id(id), _type(type)
 {
 }
 
-std::string_view VarSymbol::GetName() const
+Atom VarSymbol::GetName() const
 {
     return _name;
 }
 
-std::shared_ptr<Type> VarSymbol::GetType() const
+std::uint32_t VarSymbol::GetID() const
+{
+    return _id;
+}
+
+const Type* VarSymbol::GetType() const
 {
     return _type;
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <type/typeContext.hh>
+#include <diagnostics.hh>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace TypeContext
+{
+    static std::mutex mutex;
+    static std::unique_ptr<IntegerType> integerTypes[maxIntegerBits];
+    static std::atomic<const IntegerType*> integerSlots[maxIntegerBits];
+
+    const IntegerType* GetIntegerType(int bits)
+    {
+        if(bits < 1 || bits > maxIntegerBits)
+            Diagnostics::FatalError("viper", "unsupported integer width: " + std::to_string(bits));
+
+        std::atomic<const IntegerType*>& slot = integerSlots[bits - 1];
+        if(const IntegerType* type = slot.load(std::memory_order_acquire))
+            return type;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!integerTypes[bits - 1])
+        {
+            integerTypes[bits - 1] = std::make_unique<IntegerType>(bits);
+            slot.store(integerTypes[bits - 1].get(), std::memory_order_release);
+        }
+        return integerTypes[bits - 1].get();
+    }
+}
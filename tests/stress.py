@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+# Writes programs whose expressions are as long as the given term count, to
+# check that no part of the compiler recurses once per term
+import os
+import sys
+
+def chain(terms, term, op):
+    return f" {op} ".join([term] * terms)
+
+def nested(terms, term, op):
+    return "(" * (terms - 1) + term + f" {op} {term})" * (terms - 1)
+
+def program(body):
+    return (
+        "let int32 one() = {\n"
+        "    return 1;\n"
+        "}\n"
+        "\n"
+        "let int32 main() = {\n"
+        "    let int32 a = one();\n"
+        f"    {body}\n"
+        "}"
+    )
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(f"usage: {sys.argv[0]} <terms> <output directory>")
+    terms = int(sys.argv[1])
+    output = sys.argv[2]
+    os.makedirs(output, exist_ok=True)
+
+    programs = {
+        # Fold to a single constant while the tree is built
+        "literal_chain": f"return {chain(terms, '1', '+')};",
+        "literal_nested": f"return {nested(terms, '1', '-')};",
+        # Stay in the tree until codegen
+        "call_chain": f"return {chain(terms, 'one()', '-')};",
+        "call_nested": f"return {nested(terms, 'one()', '-')};",
+        "variable_nested": f"return {nested(terms, 'a', '+')};",
+        "assignment_chain": f"return {chain(terms, 'a', '=')};",
+    }
+    for name, body in programs.items():
+        with open(os.path.join(output, f"{name}.vpr"), "w") as file:
+            file.write(program(body))
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file